@@ -59,8 +59,13 @@ calcFlux(mfem::GridFunction * v_field, int face_attr, mfem::Coefficient & q)
     }
   }
 
+  // Reduce over the communicator of the mesh, which may be a submesh
+  MPI_Comm comm = MPI_COMM_WORLD;
+  if (auto * pfes = dynamic_cast<mfem::ParFiniteElementSpace *>(fes))
+    comm = pfes->GetComm();
+
   double total_flux;
-  MPI_Allreduce(&flux, &total_flux, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(&flux, &total_flux, 1, MPI_DOUBLE, MPI_SUM, comm);
 
   return total_flux;
 }
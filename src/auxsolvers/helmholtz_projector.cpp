@@ -1,4 +1,5 @@
 #include "helmholtz_projector.hpp"
+#include "utils.hpp"
 
 namespace hephaestus
 {
@@ -18,7 +19,7 @@ HelmholtzProjector::HelmholtzProjector(const hephaestus::InputParameters & param
 {
 
   hephaestus::InputParameters default_pars;
-  default_pars.SetParam("Tolerance", float(1.0e-20));
+  default_pars.SetParam("Tolerance", float(1.0e-12));
   default_pars.SetParam("AbsTolerance", float(1.0e-20));
   default_pars.SetParam("MaxIter", (unsigned int)1000);
   default_pars.SetParam("PrintLevel", logger.level());
@@ -36,38 +37,48 @@ HelmholtzProjector::Project(hephaestus::GridFunctions & gridfunctions,
   // Retrieving vector GridFunction. This is the only mandatory one
   _div_free_src_gf = gridfunctions.Get(_gf_grad_name);
 
+  mfem::ParFiniteElementSpace * h_curl_fe_space{nullptr};
   if (!fespaces.Has(_hcurl_fespace_name))
   {
     logger.info("{} not found in fespaces when creating {}. Obtaining from vector "
                 "GridFunction.",
                 _hcurl_fespace_name,
                 typeid(this).name());
-    _h_curl_fe_space = _div_free_src_gf->ParFESpace();
+    h_curl_fe_space = _div_free_src_gf->ParFESpace();
   }
   else
   {
-    _h_curl_fe_space = fespaces.Get(_hcurl_fespace_name);
+    h_curl_fe_space = fespaces.Get(_hcurl_fespace_name);
   }
 
-  std::unique_ptr<mfem::H1_FECollection> h1_fec{nullptr};
-
-  if (!fespaces.Has(_h1_fespace_name))
+  // Cached state is only valid for the spaces it was built on
+  if (h_curl_fe_space != _h_curl_fe_space ||
+      (fespaces.Has(_h1_fespace_name) && fespaces.GetShared(_h1_fespace_name) != _h1_fe_space))
   {
-    logger.info("{} not found in fespaces when creating {}. Extracting from GridFunction",
-                _h1_fespace_name,
-                typeid(this).name());
-
-    // Creates an H1 FES on the same mesh and with the same order as the HCurl
-    // FES
-    h1_fec = std::make_unique<mfem::H1_FECollection>(_h_curl_fe_space->GetMaxElementOrder(),
-                                                     _h_curl_fe_space->GetParMesh()->Dimension());
-
-    _h1_fe_space =
-        std::make_shared<mfem::ParFiniteElementSpace>(_h_curl_fe_space->GetParMesh(), h1_fec.get());
+    Reset();
+    _h_curl_fe_space = h_curl_fe_space;
   }
-  else
+
+  if (_h1_fe_space == nullptr)
   {
-    _h1_fe_space = fespaces.GetShared(_h1_fespace_name);
+    if (!fespaces.Has(_h1_fespace_name))
+    {
+      logger.info("{} not found in fespaces when creating {}. Extracting from GridFunction",
+                  _h1_fespace_name,
+                  typeid(this).name());
+
+      // Creates an H1 FES on the same mesh and with the same order as the HCurl
+      // FES
+      _h1_fec = std::make_unique<mfem::H1_FECollection>(
+          _h_curl_fe_space->GetMaxElementOrder(), _h_curl_fe_space->GetParMesh()->Dimension());
+
+      _h1_fe_space = std::make_shared<mfem::ParFiniteElementSpace>(_h_curl_fe_space->GetParMesh(),
+                                                                   _h1_fec.get());
+    }
+    else
+    {
+      _h1_fe_space = fespaces.GetShared(_h1_fespace_name);
+    }
   }
 
   if (!gridfunctions.Has(_gf_name))
@@ -82,7 +93,8 @@ HelmholtzProjector::Project(hephaestus::GridFunctions & gridfunctions,
     _q = gridfunctions.GetShared(_gf_name);
   }
 
-  _g = std::make_unique<mfem::ParGridFunction>(_h_curl_fe_space);
+  if (_g == nullptr)
+    _g = std::make_unique<mfem::ParGridFunction>(_h_curl_fe_space);
   *_g = *_div_free_src_gf;
   *_q = 0.0;
 
@@ -100,11 +112,26 @@ HelmholtzProjector::Project(hephaestus::GridFunctions & gridfunctions,
   *_div_free_src_gf *= -1.0;
 }
 
+void
+HelmholtzProjector::Reset()
+{
+  _g.reset();
+  _g_div.reset();
+  _weak_div.reset();
+  _a0.reset();
+  _grad.reset();
+  _a0_solver.reset();
+  _a0_matrix.Clear();
+  _system_ess_tdofs.DeleteAll();
+  _h1_fe_space.reset();
+  _h1_fec.reset();
+}
+
 void
 HelmholtzProjector::SetForms()
 {
-  if (_g_div == nullptr)
-    _g_div = std::make_unique<mfem::ParLinearForm>(_h1_fe_space.get());
+  // Rebuilt on each call, since boundary integrators are added in SetBCs
+  _g_div = std::make_unique<mfem::ParLinearForm>(_h1_fe_space.get());
 
   if (_weak_div == nullptr)
   {
@@ -113,14 +140,6 @@ HelmholtzProjector::SetForms()
     _weak_div->Assemble();
     _weak_div->Finalize();
   }
-
-  if (_a0 == nullptr)
-  {
-    _a0 = std::make_unique<mfem::ParBilinearForm>(_h1_fe_space.get());
-    _a0->AddDomainIntegrator(new mfem::DiffusionIntegrator);
-    _a0->Assemble();
-    _a0->Finalize();
-  }
 }
 
 void
@@ -140,22 +159,27 @@ HelmholtzProjector::SetBCs()
 {
   // Begin Divergence-free projection
   // (g, ∇q) - (∇Q, ∇q) - <P(g).n, q> = 0
-  int myid = _h1_fe_space->GetMyRank();
 
   // <P(g).n, q>
   _bc_map->ApplyEssentialBCs(_gf_name, _ess_bdr_tdofs, *_q, (_h1_fe_space->GetParMesh()));
   _bc_map->ApplyIntegratedBCs(_gf_name, *_g_div, (_h1_fe_space->GetParMesh()));
 
   // Apply essential BC. Necessary to ensure potential at least one point is
-  // fixed.
+  // fixed. The first true dof of the lowest rank that owns any is used, since
+  // on a submesh rank 0 may own none.
   int localsize = _ess_bdr_tdofs.Size();
   int fullsize;
-  MPI_Allreduce(&fullsize, &localsize, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(&localsize, &fullsize, 1, MPI_INT, MPI_SUM, _h1_fe_space->GetComm());
 
-  if (fullsize == 0 && myid == 0)
+  if (fullsize == 0)
   {
-    _ess_bdr_tdofs.SetSize(1);
-    _ess_bdr_tdofs[0] = 0;
+    const int ref_rank =
+        hephaestus::LowestRankWith(_h1_fe_space->GetTrueVSize() > 0, _h1_fe_space->GetComm());
+    if (_h1_fe_space->GetMyRank() == ref_rank)
+    {
+      _ess_bdr_tdofs.SetSize(1);
+      _ess_bdr_tdofs[0] = 0;
+    }
   }
 }
 
@@ -171,15 +195,36 @@ HelmholtzProjector::SolveLinearSystem()
   // Form linear system
   // (g, ∇q) - (∇Q, ∇q) - <P(g).n, q> = 0
   // (∇Q, ∇q) = (g, ∇q) - <P(g).n, q>
-  mfem::HypreParMatrix a0;
-  mfem::Vector x0;
-  mfem::Vector b0;
-  _a0->FormLinearSystem(_ess_bdr_tdofs, *_q, *_g_div, a0, x0, b0);
+  // The eliminated matrix and its AMG hierarchy are reused unless the
+  // essential DoFs have changed on any rank.
+  int local_rebuild = (_a0_solver == nullptr || _ess_bdr_tdofs.Size() != _system_ess_tdofs.Size() ||
+                       !std::equal(_ess_bdr_tdofs.begin(),
+                                   _ess_bdr_tdofs.end(),
+                                   _system_ess_tdofs.begin()));
+  int rebuild;
+  MPI_Allreduce(&local_rebuild, &rebuild, 1, MPI_INT, MPI_MAX, _h1_fe_space->GetComm());
+  if (rebuild)
+  {
+    // MFEM eliminates essential DoFs only when a form's matrix is first
+    // formed, so a new form is assembled for each set of essential DoFs.
+    _a0 = std::make_unique<mfem::ParBilinearForm>(_h1_fe_space.get());
+    _a0->AddDomainIntegrator(new mfem::DiffusionIntegrator);
+    _a0->Assemble();
+    _a0->Finalize();
+    _a0->FormSystemMatrix(_ess_bdr_tdofs, _a0_matrix);
+    _a0_solver = std::make_unique<hephaestus::DefaultH1PCGSolver>(
+        _solver_options, *_a0_matrix.As<mfem::HypreParMatrix>());
+    _system_ess_tdofs = _ess_bdr_tdofs;
+  }
 
-  hephaestus::DefaultGMRESSolver a0_solver(_solver_options, a0);
+  mfem::Vector x0(_h1_fe_space->GetTrueVSize());
+  mfem::Vector b0(_h1_fe_space->GetTrueVSize());
+  _q->ParallelProject(x0);
+  _g_div->ParallelAssemble(b0);
+  _a0->EliminateVDofsInRHS(_ess_bdr_tdofs, x0, b0);
 
-  a0_solver.Mult(b0, x0);
-  _a0->RecoverFEMSolution(x0, *_g_div, *_q);
+  _a0_solver->Mult(b0, x0);
+  _q->Distribute(x0);
 }
 
 } // namespace hephaestus
\ No newline at end of file
@@ -4,6 +4,10 @@
 namespace hephaestus
 {
 
+// Projects a vector GridFunction onto its divergence-free component. The H1
+// space, assembled forms, eliminated system and AMG hierarchy are kept between
+// calls to Project, so a long-lived projector costs one preconditioned solve
+// per projection as long as the spaces and essential DoFs are unchanged.
 class HelmholtzProjector
 {
 public:
@@ -19,12 +23,16 @@ public:
   void SolveLinearSystem();
 
 private:
+  // Drops all state tied to the H(curl) and H1 spaces.
+  void Reset();
+
   std::string _hcurl_fespace_name;
   std::string _h1_fespace_name;
   std::string _gf_grad_name;
   std::string _gf_name;
   hephaestus::InputParameters _solver_options;
 
+  std::unique_ptr<mfem::H1_FECollection> _h1_fec{nullptr};
   std::shared_ptr<mfem::ParFiniteElementSpace> _h1_fe_space{nullptr};
   mfem::ParFiniteElementSpace * _h_curl_fe_space{nullptr};
   std::shared_ptr<mfem::ParGridFunction> _q{nullptr};
@@ -40,6 +48,11 @@ private:
   std::unique_ptr<mfem::ParMixedBilinearForm> _weak_div;
   std::unique_ptr<mfem::ParDiscreteLinearOperator> _grad;
 
+  // Eliminated diffusion matrix and its solver, valid for _system_ess_tdofs
+  mfem::OperatorHandle _a0_matrix;
+  std::unique_ptr<hephaestus::DefaultH1PCGSolver> _a0_solver{nullptr};
+  mfem::Array<int> _system_ess_tdofs;
+
   mfem::Array<int> _ess_bdr_tdofs;
   hephaestus::BCMap * _bc_map;
 };
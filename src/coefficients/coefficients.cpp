@@ -1,5 +1,6 @@
 #include "coefficients.hpp"
 
+#include <algorithm>
 #include <utility>
 
 namespace hephaestus
@@ -15,6 +16,28 @@ fracFunc(double a, double b)
 {
   return a / b;
 }
+double
+absFunc(double a)
+{
+  return std::abs(a);
+}
+
+namespace
+{
+// Coefficients that cannot vary in time, regardless of SetTime.
+bool
+IsConstantCoefficient(mfem::Coefficient * coef)
+{
+  return dynamic_cast<mfem::ConstantCoefficient *>(coef) != nullptr ||
+         dynamic_cast<mfem::PWConstCoefficient *>(coef) != nullptr;
+}
+
+bool
+IsConstantCoefficient(mfem::VectorCoefficient * coef)
+{
+  return dynamic_cast<mfem::VectorConstantCoefficient *>(coef) != nullptr;
+}
+} // namespace
 
 Subdomain::Subdomain(std::string name_, int id_) : _name(std::move(name_)), _id(id_) {}
 
@@ -35,6 +58,7 @@ Coefficients::RegisterDefaultCoefficients()
 void
 Coefficients::SetTime(double time)
 {
+  const bool time_changed = (time != _t);
   for (auto const & [name, coeff_] : _scalars)
   {
     coeff_->SetTime(time);
@@ -44,6 +68,95 @@ Coefficients::SetTime(double time)
     vec_coeff_->SetTime(time);
   }
   _t = time;
+
+  if (!time_changed)
+  {
+    return;
+  }
+
+  // Derived coefficients pick up changes through their parents.
+  for (auto const & [name, coeff_] : _scalars)
+  {
+    if (!_dependencies.count(name) && IsTimeDependent(name))
+    {
+      MarkChanged(name);
+    }
+  }
+  for (auto const & [name, vec_coeff_] : _vectors)
+  {
+    if (!_dependencies.count(name) && IsTimeDependent(name))
+    {
+      MarkChanged(name);
+    }
+  }
+}
+
+void
+Coefficients::SetDependencies(const std::string & name, std::vector<std::string> parent_names)
+{
+  _dependencies[name] = std::move(parent_names);
+}
+
+void
+Coefficients::SetTimeDependent(const std::string & name, bool time_dependent)
+{
+  _time_dependence[name] = time_dependent;
+}
+
+bool
+Coefficients::IsTimeDependent(const std::string & name) const
+{
+  auto dependencies = _dependencies.find(name);
+  if (dependencies != _dependencies.end())
+  {
+    return std::any_of(dependencies->second.begin(),
+                       dependencies->second.end(),
+                       [this](const std::string & parent) { return IsTimeDependent(parent); });
+  }
+
+  auto time_dependence = _time_dependence.find(name);
+  if (time_dependence != _time_dependence.end())
+  {
+    return time_dependence->second;
+  }
+
+  if (_scalars.Has(name))
+  {
+    return !IsConstantCoefficient(_scalars.Get(name));
+  }
+  if (_vectors.Has(name))
+  {
+    return !IsConstantCoefficient(_vectors.Get(name));
+  }
+  // Unknown coefficients are assumed to vary.
+  return true;
+}
+
+void
+Coefficients::MarkChanged(const std::string & name)
+{
+  ++_sequences[name];
+}
+
+long
+Coefficients::GetSequence(const std::string & name) const
+{
+  long sequence = 0;
+  auto own_sequence = _sequences.find(name);
+  if (own_sequence != _sequences.end())
+  {
+    sequence += own_sequence->second;
+  }
+
+  auto dependencies = _dependencies.find(name);
+  if (dependencies != _dependencies.end())
+  {
+    for (const auto & parent : dependencies->second)
+    {
+      sequence += GetSequence(parent);
+    }
+  }
+  return sequence;
 }
 
 // merge subdomains?
@@ -82,29 +195,37 @@ Coefficients::AddGlobalCoefficientsFromSubdomains()
   for (auto & scalar_property_name : scalar_property_names)
   {
     mfem::Array<mfem::Coefficient *> subdomain_coefs;
+    bool time_dependent = false;
     for (auto & subdomain : _subdomains)
     {
-      subdomain_coefs.Append(subdomain._scalar_coefficients.Get(scalar_property_name));
+      auto * coef = subdomain._scalar_coefficients.Get(scalar_property_name);
+      subdomain_coefs.Append(coef);
+      time_dependent = time_dependent || !IsConstantCoefficient(coef);
     }
     if (!_scalars.Has(scalar_property_name))
     {
       _scalars.Register(scalar_property_name,
                         std::make_shared<mfem::PWCoefficient>(subdomain_ids, subdomain_coefs));
+      SetTimeDependent(scalar_property_name, time_dependent);
     }
   }
 
   for (auto & vector_property_name : vector_property_names)
   {
     mfem::Array<mfem::VectorCoefficient *> subdomain_coefs;
+    bool time_dependent = false;
     for (auto & subdomain : _subdomains)
     {
-      subdomain_coefs.Append(subdomain._vector_coefficients.Get(vector_property_name));
+      auto * coef = subdomain._vector_coefficients.Get(vector_property_name);
+      subdomain_coefs.Append(coef);
+      time_dependent = time_dependent || !IsConstantCoefficient(coef);
     }
     if (!_vectors.Has(vector_property_name))
     {
       _vectors.Register(
           vector_property_name,
           std::make_shared<mfem::PWVectorCoefficient>(3, subdomain_ids, subdomain_coefs));
+      SetTimeDependent(vector_property_name, time_dependent);
     }
   }
 }
@@ -3,6 +3,7 @@
 #include "named_fields_map.hpp"
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <unordered_set>
 
@@ -11,6 +12,7 @@ namespace hephaestus
 
 double prodFunc(double a, double b);
 double fracFunc(double a, double b);
+double absFunc(double a);
 
 class Subdomain
 {
@@ -31,19 +33,43 @@ public:
 // Stores all coefficients defined over
 class Coefficients
 {
-  double _t; // Time at which time-dependent coefficients are evaluated
+  double _t{0.0}; // Time at which time-dependent coefficients are evaluated
 public:
   Coefficients();
   ~Coefficients() = default;
 
   Coefficients(std::vector<Subdomain> subdomains_);
   void SetTime(double t);
+  [[nodiscard]] double GetTime() const { return _t; }
   void AddGlobalCoefficientsFromSubdomains();
   void RegisterDefaultCoefficients();
 
+  // Change tracking, used to avoid reassembling forms whose coefficients have
+  // not changed between solves.
+
+  // Declare that the coefficient name is evaluated from the named parent
+  // coefficients (e.g. a TransformedCoefficient), so that it is considered
+  // changed whenever one of its parents is.
+  void SetDependencies(const std::string & name, std::vector<std::string> parent_names);
+  // Override the automatic detection of whether a coefficient varies in time.
+  void SetTimeDependent(const std::string & name, bool time_dependent);
+  // Returns true if the value of the coefficient may change on calls to SetTime.
+  bool IsTimeDependent(const std::string & name) const;
+  // Signal that a coefficient has been modified outside of SetTime, for
+  // instance by changing the value of a ConstantCoefficient.
+  void MarkChanged(const std::string & name);
+  // Returns a counter that increases whenever the coefficient (or one of its
+  // parents) changes.
+  long GetSequence(const std::string & name) const;
+
   hephaestus::NamedFieldsMap<mfem::Coefficient> _scalars;
   hephaestus::NamedFieldsMap<mfem::VectorCoefficient> _vectors;
   std::vector<Subdomain> _subdomains;
+
+private:
+  std::map<std::string, std::vector<std::string>> _dependencies;
+  std::map<std::string, bool> _time_dependence;
+  std::map<std::string, long> _sequences;
 };
 
 } // namespace hephaestus
@@ -1,11 +1,68 @@
 #include "equation_system.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace hephaestus
 {
 
-EquationSystem::EquationSystem(const hephaestus::InputParameters & params) {}
+namespace
+{
+bool
+SameDofs(const mfem::Array<int> & a, const mfem::Array<int> & b)
+{
+  return a.Size() == b.Size() && std::equal(a.begin(), a.end(), b.begin());
+}
+} // namespace
+
+EquationSystem::EquationSystem(const hephaestus::InputParameters & params)
+  : _assembly_level(
+        ParseAssemblyLevel(params.GetOptionalParam<std::string>("AssemblyLevel", "Full"))),
+    _monolithic(params.GetOptionalParam<bool>("Monolithic", true)),
+    _persistent_sparsity(params.GetOptionalParam<bool>("PersistentSparsity", true))
+{
+  // Matrix-free diagonal blocks cannot be merged into a monolithic matrix
+  if (_assembly_level != mfem::AssemblyLevel::LEGACY)
+  {
+    _monolithic = false;
+  }
+  _operators.SetAssemblyLevel(_assembly_level);
+}
 
-EquationSystem::~EquationSystem() { _h_blocks.DeleteAll(); }
+mfem::AssemblyLevel
+EquationSystem::ParseAssemblyLevel(const std::string & assembly_level_name)
+{
+  if (assembly_level_name == "Full")
+  {
+    return mfem::AssemblyLevel::LEGACY;
+  }
+  else if (assembly_level_name == "Element")
+  {
+    return mfem::AssemblyLevel::ELEMENT;
+  }
+  else if (assembly_level_name == "Partial")
+  {
+    return mfem::AssemblyLevel::PARTIAL;
+  }
+  MFEM_ABORT("Unknown AssemblyLevel " << assembly_level_name
+                                      << "; expected Full, Element or Partial.");
+  return mfem::AssemblyLevel::LEGACY;
+}
+
+EquationSystem::~EquationSystem() { DeleteBlocks(); }
+
+void
+EquationSystem::DeleteBlocks()
+{
+  for (int i = 0; i < _h_blocks.NumRows(); i++)
+  {
+    for (int j = 0; j < _h_blocks.NumCols(); j++)
+    {
+      delete _h_blocks(i, j);
+    }
+  }
+  _h_blocks.DeleteAll();
+}
 
 bool
 EquationSystem::VectorContainsName(const std::vector<std::string> & the_vector,
@@ -50,6 +107,7 @@ EquationSystem::AddKernel(const std::string & test_var_name,
     _blf_kernels_map.Register(test_var_name, std::move(kernels));
   }
 
+  blf_kernel->SetOperatorRegistry(&_operators);
   _blf_kernels_map.GetRef(test_var_name).push_back(std::move(blf_kernel));
 }
 
@@ -66,6 +124,7 @@ EquationSystem::AddKernel(const std::string & test_var_name,
     _lf_kernels_map.Register(test_var_name, std::move(kernels));
   }
 
+  lf_kernel->SetOperatorRegistry(&_operators);
   _lf_kernels_map.GetRef(test_var_name).push_back(std::move(lf_kernel));
 }
 
@@ -82,6 +141,7 @@ EquationSystem::AddKernel(const std::string & test_var_name,
     _nlf_kernels_map.Register(test_var_name, std::move(kernels));
   }
 
+  nlf_kernel->SetOperatorRegistry(&_operators);
   _nlf_kernels_map.GetRef(test_var_name).push_back(std::move(nlf_kernel));
 }
 
@@ -110,11 +170,21 @@ EquationSystem::AddKernel(const std::string & trial_var_name,
     _mblf_kernels_map_map.Get(test_var_name)->Register(trial_var_name, std::move(kernels));
   }
 
+  mblf_kernel->SetOperatorRegistry(&_operators);
   _mblf_kernels_map_map.GetRef(test_var_name)
       .Get(trial_var_name)
       ->push_back(std::move(mblf_kernel));
 }
 
+void
+EquationSystem::AddTransposedBlock(const std::string & trial_var_name,
+                                   const std::string & test_var_name,
+                                   double scale)
+{
+  AddTestVariableNameIfMissing(test_var_name);
+  _transposed_blocks[{test_var_name, trial_var_name}] = scale;
+}
+
 void
 EquationSystem::ApplyBoundaryConditions(hephaestus::BCMap & bc_map)
 {
@@ -136,22 +206,20 @@ EquationSystem::FormLinearSystem(mfem::OperatorHandle & op,
                                  mfem::BlockVector & trueX,
                                  mfem::BlockVector & trueRHS)
 {
+  const bool reuse_structure = _persistent_sparsity && CanReuseJacobianStructure(op);
 
   // Allocate block operator
-  _h_blocks.DeleteAll();
-  _h_blocks.SetSize(_test_var_names.size(), _test_var_names.size());
+  if (!reuse_structure)
+  {
+    DeleteBlocks();
+    _h_blocks.SetSize(_test_var_names.size(), _test_var_names.size());
+    _h_blocks = nullptr;
+  }
   // Form diagonal blocks.
+  _diagonal_operators.resize(_test_var_names.size());
   for (int i = 0; i < _test_var_names.size(); i++)
   {
-    auto & test_var_name = _test_var_names.at(i);
-    auto blf = _blfs.Get(test_var_name);
-    auto lf = _lfs.Get(test_var_name);
-    mfem::Vector aux_x, aux_rhs;
-    _h_blocks(i, i) = new mfem::HypreParMatrix;
-    blf->FormLinearSystem(
-        _ess_tdof_lists.at(i), *(_xs.at(i)), *lf, *_h_blocks(i, i), aux_x, aux_rhs);
-    trueX.GetBlock(i) = aux_x;
-    trueRHS.GetBlock(i) = aux_rhs;
+    FormDiagonalBlock(i, trueX.GetBlock(i), trueRHS.GetBlock(i));
   }
 
   // Form off-diagonal blocks
@@ -168,7 +236,10 @@ EquationSystem::FormLinearSystem(mfem::OperatorHandle & op,
       if (_mblfs.Has(test_var_name) && _mblfs.Get(test_var_name)->Has(trial_var_name))
       {
         auto mblf = _mblfs.Get(test_var_name)->Get(trial_var_name);
-        _h_blocks(i, j) = new mfem::HypreParMatrix;
+        if (_h_blocks(i, j) == nullptr)
+        {
+          _h_blocks(i, j) = new mfem::HypreParMatrix;
+        }
         mblf->FormRectangularLinearSystem(_ess_tdof_lists.at(j),
                                           _ess_tdof_lists.at(i),
                                           *(_xs.at(j)),
@@ -180,6 +251,8 @@ EquationSystem::FormLinearSystem(mfem::OperatorHandle & op,
       }
     }
   }
+  FormTransposedBlocks(trueRHS);
+
   // Sync memory
   for (int i = 0; i < _test_var_names.size(); i++)
   {
@@ -187,8 +260,432 @@ EquationSystem::FormLinearSystem(mfem::OperatorHandle & op,
     trueRHS.GetBlock(0).SyncAliasMemory(trueRHS);
   }
 
+  if (!_monolithic)
+  {
+    // Keep blocks separate, for use with block preconditioners
+    auto block_of = [this](int i, int j) -> mfem::Operator *
+    {
+      if (i == j && _assembly_level != mfem::AssemblyLevel::LEGACY)
+      {
+        return _diagonal_operators.at(i).Ptr();
+      }
+      return _h_blocks(i, j);
+    };
+
+    // The existing block operator is still valid if its blocks are the same
+    // objects, whose values have been updated in place
+    if (reuse_structure)
+    {
+      auto * block_op = op.As<mfem::BlockOperator>();
+      bool same_blocks = true;
+      for (int i = 0; i < _test_var_names.size(); i++)
+      {
+        for (int j = 0; j < _test_var_names.size(); j++)
+        {
+          const mfem::Operator * block =
+              block_op->IsZeroBlock(i, j) ? nullptr : &block_op->GetBlock(i, j);
+          same_blocks = same_blocks && (block == block_of(i, j));
+        }
+      }
+      if (same_blocks)
+      {
+        return;
+      }
+    }
+
+    _block_offsets.SetSize(_test_var_names.size() + 1);
+    _block_offsets[0] = 0;
+    for (int i = 0; i < _test_var_names.size(); i++)
+    {
+      _block_offsets[i + 1] = _test_pfespaces.at(i)->TrueVSize();
+    }
+    _block_offsets.PartialSum();
+
+    auto * block_op = new mfem::BlockOperator(_block_offsets);
+    for (int i = 0; i < _test_var_names.size(); i++)
+    {
+      for (int j = 0; j < _test_var_names.size(); j++)
+      {
+        if (block_of(i, j) != nullptr)
+        {
+          block_op->SetBlock(i, j, block_of(i, j));
+        }
+      }
+    }
+    op.Reset(block_op);
+    _jacobian_structure_sequence++;
+
+    if (_persistent_sparsity)
+    {
+      RecordJacobianStructure(op.Ptr());
+    }
+    return;
+  }
+
+  // Overwrite the values of the existing monolithic matrix if possible
+  if (reuse_structure && UpdateMonolithicValues(*op.As<mfem::HypreParMatrix>()))
+  {
+    return;
+  }
+
   // Create monolithic matrix
   op.Reset(mfem::HypreParMatrixFromBlocks(_h_blocks));
+  _jacobian_structure_sequence++;
+
+  if (_persistent_sparsity)
+  {
+    BuildMonolithicValueMaps(*op.As<mfem::HypreParMatrix>());
+  }
+}
+
+void
+EquationSystem::FormDiagonalBlock(int i, mfem::Vector & trueX, mfem::Vector & trueRHS)
+{
+  auto & test_var_name = _test_var_names.at(i);
+  auto blf = _blfs.Get(test_var_name);
+  auto lf = _lfs.Get(test_var_name);
+  mfem::Vector aux_x, aux_rhs;
+  if (_assembly_level != mfem::AssemblyLevel::LEGACY)
+  {
+    blf->FormLinearSystem(
+        _ess_tdof_lists.at(i), *(_xs.at(i)), *lf, _diagonal_operators.at(i), aux_x, aux_rhs);
+  }
+  else
+  {
+    if (_h_blocks(i, i) == nullptr)
+    {
+      _h_blocks(i, i) = new mfem::HypreParMatrix;
+    }
+    blf->FormLinearSystem(
+        _ess_tdof_lists.at(i), *(_xs.at(i)), *lf, *_h_blocks(i, i), aux_x, aux_rhs);
+  }
+  trueX = aux_x;
+  trueRHS = aux_rhs;
+}
+
+std::vector<std::pair<std::shared_ptr<mfem::ParBilinearForm>, double>>
+EquationSystem::GetBilinearFormTerms(const std::string & test_var_name)
+{
+  auto iter = std::find(_test_var_names.begin(), _test_var_names.end(), test_var_name);
+  MFEM_VERIFY(iter != _test_var_names.end(),
+              "Variable " << test_var_name << " is not a test variable.");
+  auto * fespace = _test_pfespaces.at(std::distance(_test_var_names.begin(), iter));
+
+  auto blf = std::make_shared<mfem::ParBilinearForm>(fespace);
+  if (_blf_kernels_map.Has(test_var_name))
+  {
+    for (auto & blf_kernel : _blf_kernels_map.GetRef(test_var_name))
+    {
+      blf_kernel->AddIntegrators(blf.get());
+    }
+  }
+  return {{blf, 1.0}};
+}
+
+void
+EquationSystem::FormTransposedBlocks(mfem::BlockVector & trueRHS)
+{
+  auto index_of = [this](const std::string & name)
+  {
+    auto iter = std::find(_test_var_names.begin(), _test_var_names.end(), name);
+    MFEM_VERIFY(iter != _test_var_names.end(), "Variable " << name << " is not a test variable.");
+    return static_cast<int>(std::distance(_test_var_names.begin(), iter));
+  };
+
+  for (const auto & [var_names, scale] : _transposed_blocks)
+  {
+    const auto & [test_var_name, trial_var_name] = var_names;
+    const int i = index_of(test_var_name);
+    const int j = index_of(trial_var_name);
+
+    MFEM_VERIFY(!(_mblf_kernels_map_map.Has(test_var_name) &&
+                  _mblf_kernels_map_map.Get(test_var_name)->Has(trial_var_name)),
+                "Block (" << test_var_name << ", " << trial_var_name
+                          << ") has kernels and cannot be formed by transposition.");
+    MFEM_VERIFY(_h_blocks(j, i) != nullptr && _transposed_source_mats.count(var_names),
+                "Block (" << trial_var_name << ", " << test_var_name
+                          << ") must be assembled to form its transpose.");
+
+    // Rows and columns of essential DoFs are eliminated in both blocks, so the
+    // transpose of the eliminated block is the eliminated transposed block.
+    std::unique_ptr<mfem::HypreParMatrix> transposed(_h_blocks(j, i)->Transpose());
+    *transposed *= scale;
+    if (_h_blocks(i, j) == nullptr)
+    {
+      _h_blocks(i, j) = new mfem::HypreParMatrix;
+    }
+    _h_blocks(i, j)->MakeRef(*transposed);
+    _transposed_block_mats[var_names] = std::move(transposed);
+
+    // The eliminated columns of the transposed block are the eliminated rows
+    // of the assembled block, which must be applied to the essential values of
+    // the trial variable here.
+    auto * test_fespace = _test_pfespaces.at(i);
+    auto * trial_fespace = _test_pfespaces.at(j);
+    mfem::Vector trial_true(trial_fespace->GetTrueVSize());
+    _xs.at(j)->GetTrueDofs(trial_true);
+    mfem::Vector trial_ess_true(trial_fespace->GetTrueVSize());
+    trial_ess_true = 0.0;
+    for (int tdof : _ess_tdof_lists.at(j))
+    {
+      trial_ess_true(tdof) = trial_true(tdof);
+    }
+    mfem::Vector trial_ess(trial_fespace->GetVSize());
+    trial_fespace->GetProlongationMatrix()->Mult(trial_ess_true, trial_ess);
+
+    mfem::Vector test_aux(test_fespace->GetVSize());
+    _transposed_source_mats.at(var_names)->MultTranspose(trial_ess, test_aux);
+    mfem::Vector test_aux_true(test_fespace->GetTrueVSize());
+    test_fespace->GetProlongationMatrix()->MultTranspose(test_aux, test_aux_true);
+    test_aux_true.SetSubVector(_ess_tdof_lists.at(i), 0.0);
+    trueRHS.GetBlock(i).Add(-scale, test_aux_true);
+  }
+}
+
+bool
+EquationSystem::CanReuseJacobianStructure(const mfem::OperatorHandle & op) const
+{
+  if (op.Ptr() == nullptr || op.Ptr() != _jacobian_operator ||
+      _h_blocks.NumRows() != _test_var_names.size())
+  {
+    return false;
+  }
+  for (int i = 0; i < _test_var_names.size(); i++)
+  {
+    if (_test_pfespaces.at(i)->GetSequence() != _jacobian_fespace_sequences.at(i))
+    {
+      return false;
+    }
+    if (!SameDofs(_ess_tdof_lists.at(i), _jacobian_ess_tdof_lists.at(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void
+EquationSystem::RecordJacobianStructure(const mfem::Operator * jacobian)
+{
+  _jacobian_operator = jacobian;
+  _jacobian_fespace_sequences.clear();
+  for (auto * fespace : _test_pfespaces)
+  {
+    _jacobian_fespace_sequences.push_back(fespace->GetSequence());
+  }
+  _jacobian_ess_tdof_lists = _ess_tdof_lists;
+}
+
+void
+EquationSystem::BuildMonolithicValueMaps(mfem::HypreParMatrix & monolithic)
+{
+  _jacobian_operator = nullptr;
+  _block_value_maps.clear();
+
+  const int n_blocks = _test_var_names.size();
+  MPI_Comm comm = monolithic.GetComm();
+  int n_ranks, rank;
+  MPI_Comm_size(comm, &n_ranks);
+  MPI_Comm_rank(comm, &rank);
+
+  // Gather the true DoF partitioning of each variable on all ranks, from which
+  // the column numbering of HypreParMatrixFromBlocks can be reconstructed.
+  std::vector<HYPRE_BigInt> local_partitioning(2 * n_blocks);
+  for (int j = 0; j < n_blocks; j++)
+  {
+    local_partitioning[2 * j] = _test_pfespaces.at(j)->GetMyTDofOffset();
+    local_partitioning[2 * j + 1] = _test_pfespaces.at(j)->TrueVSize();
+  }
+  std::vector<HYPRE_BigInt> partitioning(2 * n_blocks * n_ranks);
+  MPI_Allgather(local_partitioning.data(),
+                2 * n_blocks,
+                mfem::MPITypeMap<HYPRE_BigInt>::mpi_type,
+                partitioning.data(),
+                2 * n_blocks,
+                mfem::MPITypeMap<HYPRE_BigInt>::mpi_type,
+                comm);
+
+  auto block_start = [&](int p, int j) { return partitioning[2 * (p * n_blocks + j)]; };
+  auto block_size = [&](int p, int j) { return partitioning[2 * (p * n_blocks + j) + 1]; };
+
+  // First monolithic column owned by each rank, and offset of each block
+  // within the columns owned by that rank.
+  std::vector<HYPRE_BigInt> monolithic_start(n_ranks, 0);
+  std::vector<HYPRE_BigInt> block_offset(n_ranks * n_blocks, 0);
+  for (int p = 0; p < n_ranks; p++)
+  {
+    HYPRE_BigInt offset = 0;
+    for (int j = 0; j < n_blocks; j++)
+    {
+      monolithic_start[p] += block_start(p, j);
+      block_offset[p * n_blocks + j] = offset;
+      offset += block_size(p, j);
+    }
+  }
+
+  // First global column of block column j owned by each rank, in rank order
+  std::vector<std::vector<HYPRE_BigInt>> block_starts(n_blocks,
+                                                      std::vector<HYPRE_BigInt>(n_ranks));
+  for (int j = 0; j < n_blocks; j++)
+  {
+    for (int p = 0; p < n_ranks; p++)
+    {
+      block_starts[j][p] = block_start(p, j);
+    }
+  }
+
+  // Map a global column of block column j to a global monolithic column. The
+  // owner is the last rank whose first column does not exceed col.
+  auto monolithic_column = [&](int j, HYPRE_BigInt col)
+  {
+    const auto & starts = block_starts[j];
+    const int owner = std::max<int>(
+        std::distance(starts.begin(), std::upper_bound(starts.begin(), starts.end(), col)) - 1,
+        0);
+    return monolithic_start[owner] + block_offset[owner * n_blocks + j] +
+           (col - block_start(owner, j));
+  };
+
+  monolithic.HostRead();
+  mfem::SparseMatrix monolithic_diag, monolithic_offd;
+  HYPRE_BigInt * monolithic_cmap;
+  monolithic.GetDiag(monolithic_diag);
+  monolithic.GetOffd(monolithic_offd, monolithic_cmap);
+  const int * diag_i = monolithic_diag.GetI();
+  const int * diag_j = monolithic_diag.GetJ();
+  const int * offd_i = monolithic_offd.GetI();
+  const int * offd_j = monolithic_offd.GetJ();
+
+  // Locate a monolithic column in a local row of the monolithic matrix
+  auto find_position = [&](int row, HYPRE_BigInt col)
+  {
+    const HYPRE_BigInt local_col = col - monolithic_start[rank];
+    if (local_col >= 0 && local_col < monolithic.Width())
+    {
+      for (int k = diag_i[row]; k < diag_i[row + 1]; k++)
+      {
+        if (diag_j[k] == local_col)
+        {
+          return k;
+        }
+      }
+    }
+    else
+    {
+      for (int k = offd_i[row]; k < offd_i[row + 1]; k++)
+      {
+        if (monolithic_cmap[offd_j[k]] == col)
+        {
+          return -(k + 1);
+        }
+      }
+    }
+    return std::numeric_limits<int>::min();
+  };
+
+  for (int i = 0; i < n_blocks; i++)
+  {
+    const int row_offset = block_offset[rank * n_blocks + i];
+    for (int j = 0; j < n_blocks; j++)
+    {
+      if (_h_blocks(i, j) == nullptr)
+      {
+        continue;
+      }
+      auto & block = *_h_blocks(i, j);
+      block.HostRead();
+      mfem::SparseMatrix block_diag, block_offd;
+      HYPRE_BigInt * block_cmap;
+      block.GetDiag(block_diag);
+      block.GetOffd(block_offd, block_cmap);
+
+      auto & value_map = _block_value_maps[{i, j}];
+      value_map._diag_positions.reserve(block_diag.NumNonZeroElems());
+      value_map._offd_positions.reserve(block_offd.NumNonZeroElems());
+
+      for (int row = 0; row < block.Height(); row++)
+      {
+        for (int k = block_diag.GetI()[row]; k < block_diag.GetI()[row + 1]; k++)
+        {
+          const HYPRE_BigInt col = monolithic_start[rank] + block_offset[rank * n_blocks + j] +
+                                   block_diag.GetJ()[k];
+          value_map._diag_positions.push_back(find_position(row_offset + row, col));
+        }
+        for (int k = block_offd.GetI()[row]; k < block_offd.GetI()[row + 1]; k++)
+        {
+          const HYPRE_BigInt col = monolithic_column(j, block_cmap[block_offd.GetJ()[k]]);
+          value_map._offd_positions.push_back(find_position(row_offset + row, col));
+        }
+      }
+
+      // Entries missing from the monolithic matrix; always rebuild it instead.
+      auto not_found = [](int position) { return position == std::numeric_limits<int>::min(); };
+      if (std::any_of(value_map._diag_positions.begin(),
+                      value_map._diag_positions.end(),
+                      not_found) ||
+          std::any_of(value_map._offd_positions.begin(),
+                      value_map._offd_positions.end(),
+                      not_found))
+      {
+        _block_value_maps.clear();
+        return;
+      }
+    }
+  }
+
+  RecordJacobianStructure(&monolithic);
+}
+
+bool
+EquationSystem::UpdateMonolithicValues(mfem::HypreParMatrix & monolithic)
+{
+  monolithic.HostReadWrite();
+  mfem::SparseMatrix monolithic_diag, monolithic_offd;
+  HYPRE_BigInt * monolithic_cmap;
+  monolithic.GetDiag(monolithic_diag);
+  monolithic.GetOffd(monolithic_offd, monolithic_cmap);
+  double * diag_data = monolithic_diag.GetData();
+  double * offd_data = monolithic_offd.GetData();
+
+  auto set_value = [&](int position, double value)
+  {
+    if (position >= 0)
+    {
+      diag_data[position] = value;
+    }
+    else
+    {
+      offd_data[-(position + 1)] = value;
+    }
+  };
+
+  for (auto & [block_index, value_map] : _block_value_maps)
+  {
+    auto & block = *_h_blocks(block_index.first, block_index.second);
+    block.HostRead();
+    mfem::SparseMatrix block_diag, block_offd;
+    HYPRE_BigInt * block_cmap;
+    block.GetDiag(block_diag);
+    block.GetOffd(block_offd, block_cmap);
+
+    if (block_diag.NumNonZeroElems() != value_map._diag_positions.size() ||
+        block_offd.NumNonZeroElems() != value_map._offd_positions.size())
+    {
+      return false;
+    }
+
+    const double * block_diag_data = block_diag.GetData();
+    for (int k = 0; k < value_map._diag_positions.size(); k++)
+    {
+      set_value(value_map._diag_positions[k], block_diag_data[k]);
+    }
+    const double * block_offd_data = block_offd.GetData();
+    for (int k = 0; k < value_map._offd_positions.size(); k++)
+    {
+      set_value(value_map._offd_positions[k], block_offd_data[k]);
+    }
+  }
+  return true;
 }
 
 void
@@ -243,6 +740,7 @@ EquationSystem::Init(hephaestus::GridFunctions & gridfunctions,
     }
     // Store pointers to variable FESpaces
     _test_pfespaces.push_back(gridfunctions.Get(test_var_name)->ParFESpace());
+    _fespace_sequences.push_back(_test_pfespaces.back()->GetSequence());
     // Create auxiliary gridfunctions for applying Dirichlet conditions
     _xs.emplace_back(
         std::make_unique<mfem::ParGridFunction>(gridfunctions.Get(test_var_name)->ParFESpace()));
@@ -323,17 +821,106 @@ EquationSystem::BuildLinearForms(hephaestus::BCMap & bc_map, hephaestus::Sources
   }
 }
 
+void
+EquationSystem::MarkFormsDirty()
+{
+  _rebuild_blfs = true;
+  _rebuild_mblfs = true;
+}
+
+void
+EquationSystem::CheckFESpaceSequences()
+{
+  for (int i = 0; i < _test_pfespaces.size(); i++)
+  {
+    const long sequence = _test_pfespaces.at(i)->GetSequence();
+    if (_fespace_sequences.at(i) != sequence)
+    {
+      _fespace_sequences.at(i) = sequence;
+      MarkFormsDirty();
+    }
+  }
+}
+
+bool
+EquationSystem::EssentialDofsChanged(const std::string & var_name,
+                                     const mfem::Array<int> & ess_tdof_list) const
+{
+  auto iter = std::find(_test_var_names.begin(), _test_var_names.end(), var_name);
+  MFEM_VERIFY(iter != _test_var_names.end(), "Variable " << var_name << " is not a test variable.");
+  return !SameDofs(_ess_tdof_lists.at(std::distance(_test_var_names.begin(), iter)),
+                   ess_tdof_list);
+}
+
+bool
+EquationSystem::BilinearFormIsDirty(const std::string & test_var_name) const
+{
+  if (_rebuild_blfs || !_blfs.Has(test_var_name) || !_blf_ess_tdof_lists.count(test_var_name) ||
+      EssentialDofsChanged(test_var_name, _blf_ess_tdof_lists.at(test_var_name)))
+  {
+    return true;
+  }
+  if (_blf_kernels_map.Has(test_var_name))
+  {
+    for (const auto & blf_kernel : _blf_kernels_map.GetRef(test_var_name))
+    {
+      if (blf_kernel->IsDirty())
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool
+EquationSystem::MixedBilinearFormIsDirty(const std::string & test_var_name,
+                                         const std::string & trial_var_name) const
+{
+  if (_rebuild_mblfs || !_mblfs.Has(test_var_name) ||
+      !_mblfs.Get(test_var_name)->Has(trial_var_name))
+  {
+    return true;
+  }
+  auto ess_tdof_lists = _mblf_ess_tdof_lists.find({test_var_name, trial_var_name});
+  if (ess_tdof_lists == _mblf_ess_tdof_lists.end() ||
+      EssentialDofsChanged(test_var_name, ess_tdof_lists->second.first) ||
+      EssentialDofsChanged(trial_var_name, ess_tdof_lists->second.second))
+  {
+    return true;
+  }
+  auto & mblf_kernels = _mblf_kernels_map_map.GetRef(test_var_name).GetRef(trial_var_name);
+  for (const auto & mblf_kernel : mblf_kernels)
+  {
+    if (mblf_kernel->IsDirty())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 void
 EquationSystem::BuildBilinearForms()
 {
+  CheckFESpaceSequences();
+
   // Register bilinear forms
   for (int i = 0; i < _test_var_names.size(); i++)
   {
     auto test_var_name = _test_var_names.at(i);
+    // Keep previously assembled forms if nothing they depend on has changed
+    if (!BilinearFormIsDirty(test_var_name))
+    {
+      continue;
+    }
     _blfs.Register(test_var_name, std::make_shared<mfem::ParBilinearForm>(_test_pfespaces.at(i)));
+    _blf_ess_tdof_lists[test_var_name] = _ess_tdof_lists.at(i);
+    _jacobian_values_sequence++;
 
     // Apply kernels
     auto blf = _blfs.Get(test_var_name);
+    blf->SetAssemblyLevel(_assembly_level);
     if (_blf_kernels_map.Has(test_var_name))
     {
       auto blf_kernels = _blf_kernels_map.GetRef(test_var_name);
@@ -345,12 +932,24 @@ EquationSystem::BuildBilinearForms()
     }
     // Assemble
     blf->Assemble();
+
+    if (_blf_kernels_map.Has(test_var_name))
+    {
+      for (auto & blf_kernel : _blf_kernels_map.GetRef(test_var_name))
+      {
+        blf_kernel->ApplyAssembled(blf);
+        blf_kernel->MarkClean();
+      }
+    }
   }
+  _rebuild_blfs = false;
 }
 
 void
 EquationSystem::BuildMixedBilinearForms()
 {
+  CheckFESpaceSequences();
+
   // Register mixed linear forms. Note that not all combinations may
   // have a kernel
 
@@ -358,7 +957,14 @@ EquationSystem::BuildMixedBilinearForms()
   for (int i = 0; i < _test_var_names.size(); i++)
   {
     auto test_var_name = _test_var_names.at(i);
-    auto test_mblfs = std::make_shared<hephaestus::NamedFieldsMap<mfem::ParMixedBilinearForm>>();
+    // Register all mixed bilinear form sets associated with a single test
+    // variable
+    if (!_mblfs.Has(test_var_name))
+    {
+      _mblfs.Register(test_var_name,
+                      std::make_shared<hephaestus::NamedFieldsMap<mfem::ParMixedBilinearForm>>());
+    }
+    auto test_mblfs = _mblfs.Get(test_var_name);
     for (int j = 0; j < _test_var_names.size(); j++)
     {
       auto trial_var_name = _test_var_names.at(j);
@@ -368,9 +974,17 @@ EquationSystem::BuildMixedBilinearForms()
       if (_mblf_kernels_map_map.Has(test_var_name) &&
           _mblf_kernels_map_map.Get(test_var_name)->Has(trial_var_name))
       {
+        // Keep previously assembled forms if nothing they depend on has changed
+        if (!MixedBilinearFormIsDirty(test_var_name, trial_var_name))
+        {
+          continue;
+        }
         auto mblf_kernels = _mblf_kernels_map_map.GetRef(test_var_name).GetRef(trial_var_name);
         auto mblf = std::make_shared<mfem::ParMixedBilinearForm>(_test_pfespaces.at(j),
                                                                  _test_pfespaces.at(i));
+        _mblf_ess_tdof_lists[{test_var_name, trial_var_name}] = {_ess_tdof_lists.at(i),
+                                                                 _ess_tdof_lists.at(j)};
+        _jacobian_values_sequence++;
         // Apply all mixed kernels with this test/trial pair
         for (auto & mblf_kernel : mblf_kernels)
         {
@@ -378,15 +992,26 @@ EquationSystem::BuildMixedBilinearForms()
         }
         // Assemble mixed bilinear forms
         mblf->Assemble();
+        for (auto & mblf_kernel : mblf_kernels)
+        {
+          mblf_kernel->ApplyAssembled(mblf.get());
+          mblf_kernel->MarkClean();
+        }
+        // Keep the unreduced matrix of the source of a transposed block
+        const std::pair<std::string, std::string> transposed_key{trial_var_name, test_var_name};
+        if (_transposed_blocks.count(transposed_key))
+        {
+          mblf->Finalize();
+          _transposed_source_mats[transposed_key] =
+              std::make_unique<mfem::SparseMatrix>(mblf->SpMat());
+        }
         // Register mixed bilinear forms associated with a single trial variable
         // for the current test variable
         test_mblfs->Register(trial_var_name, mblf);
       }
     }
-    // Register all mixed bilinear form sets associated with a single test
-    // variable
-    _mblfs.Register(test_var_name, test_mblfs);
   }
+  _rebuild_mblfs = false;
 }
 
 void
@@ -398,7 +1023,9 @@ EquationSystem::BuildEquationSystem(hephaestus::BCMap & bc_map, hephaestus::Sour
 }
 
 TimeDependentEquationSystem::TimeDependentEquationSystem(const hephaestus::InputParameters & params)
-  : EquationSystem(params), _dt_coef(1.0)
+  : EquationSystem(params),
+    _dt_coef(1.0),
+    _operator_splitting(params.GetOptionalParam<bool>("OperatorSplitting", true))
 {
 }
 
@@ -415,17 +1042,259 @@ TimeDependentEquationSystem::AddTrialVariableNameIfMissing(const std::string & v
   }
 }
 
+void
+TimeDependentEquationSystem::AddTimeStepScaledKernel(
+    const std::string & test_var_name, std::shared_ptr<ParBilinearFormKernel> blf_kernel)
+{
+  AddTestVariableNameIfMissing(test_var_name);
+
+  if (!_dt_blf_kernels_map.Has(test_var_name))
+  {
+    auto kernels = std::make_shared<std::vector<std::shared_ptr<ParBilinearFormKernel>>>();
+
+    _dt_blf_kernels_map.Register(test_var_name, std::move(kernels));
+  }
+
+  blf_kernel->SetOperatorRegistry(&_operators);
+  _dt_blf_kernels_map.GetRef(test_var_name).push_back(std::move(blf_kernel));
+}
+
+void
+TimeDependentEquationSystem::Init(hephaestus::GridFunctions & gridfunctions,
+                                  const hephaestus::FESpaces & fespaces,
+                                  hephaestus::BCMap & bc_map,
+                                  hephaestus::Coefficients & coefficients)
+{
+  EquationSystem::Init(gridfunctions, fespaces, bc_map, coefficients);
+
+  // Initialise time step scaled bilinear form kernels
+  for (const auto & [test_var_name, blf_kernels] : _dt_blf_kernels_map)
+  {
+    for (auto & i : *blf_kernels)
+    {
+      i->Init(gridfunctions, fespaces, bc_map, coefficients);
+    }
+  }
+}
+
+bool
+TimeDependentEquationSystem::TimeStepScaledFormIsDirty(const std::string & test_var_name) const
+{
+  if (_rebuild_blfs || !_dt_blfs.Has(test_var_name) || !_blf_ess_tdof_lists.count(test_var_name) ||
+      EssentialDofsChanged(test_var_name, _blf_ess_tdof_lists.at(test_var_name)))
+  {
+    return true;
+  }
+  for (const auto & blf_kernel : _dt_blf_kernels_map.GetRef(test_var_name))
+  {
+    if (blf_kernel->IsDirty())
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+TimeDependentEquationSystem::BuildBilinearForms()
+{
+  CheckFESpaceSequences();
+
+  // Assemble and finalize a bilinear form from a set of kernels
+  auto assemble = [this](mfem::ParFiniteElementSpace * fespace,
+                         std::vector<std::shared_ptr<ParBilinearFormKernel>> * kernels)
+  {
+    auto blf = std::make_shared<mfem::ParBilinearForm>(fespace);
+    blf->SetAssemblyLevel(_assembly_level);
+    if (kernels)
+    {
+      for (auto & kernel : *kernels)
+      {
+        kernel->Apply(blf.get());
+      }
+    }
+    blf->Assemble();
+    if (kernels)
+    {
+      for (auto & kernel : *kernels)
+      {
+        kernel->ApplyAssembled(blf.get());
+        kernel->MarkClean();
+      }
+    }
+    blf->Finalize();
+    return blf;
+  };
+
+  for (int i = 0; i < _test_var_names.size(); i++)
+  {
+    auto test_var_name = _test_var_names.at(i);
+    const bool has_dt_kernels = _dt_blf_kernels_map.Has(test_var_name);
+    const bool assembled = (_assembly_level == mfem::AssemblyLevel::LEGACY);
+    const bool rebuild_unscaled = BilinearFormIsDirty(test_var_name);
+    const bool rebuild_scaled = has_dt_kernels && TimeStepScaledFormIsDirty(test_var_name);
+
+    // Keep previously assembled forms if nothing they depend on has changed
+    if (!rebuild_unscaled && !rebuild_scaled && !(has_dt_kernels && _recombine_blfs))
+    {
+      continue;
+    }
+    _blf_ess_tdof_lists[test_var_name] = _ess_tdof_lists.at(i);
+    _jacobian_values_sequence++;
+
+    // M, from the kernels not scaled by the time step
+    if (rebuild_unscaled)
+    {
+      _blfs.Register(test_var_name,
+                     assemble(_test_pfespaces.at(i),
+                              _blf_kernels_map.Has(test_var_name)
+                                  ? _blf_kernels_map.Get(test_var_name)
+                                  : nullptr));
+    }
+
+    // K, from the kernels scaled by the time step
+    if (rebuild_scaled)
+    {
+      _dt_blfs.Register(test_var_name,
+                        assemble(_test_pfespaces.at(i), _dt_blf_kernels_map.Get(test_var_name)));
+    }
+
+    // Form M + dt K, leaving the matrices of M and K untouched. Matrix-free
+    // forms are summed when the linear system is formed instead.
+    if (has_dt_kernels && assembled)
+    {
+      _combined_operators.resize(_test_var_names.size());
+      _combined_operators.at(i).reset();
+      _combined_mats.Register(test_var_name,
+                              std::shared_ptr<mfem::SparseMatrix>(
+                                  mfem::Add(1.0,
+                                            _blfs.Get(test_var_name)->SpMat(),
+                                            _dt_coef.constant,
+                                            _dt_blfs.Get(test_var_name)->SpMat())));
+    }
+  }
+  _rebuild_blfs = false;
+  _recombine_blfs = false;
+}
+
+void
+TimeDependentEquationSystem::FormDiagonalBlock(int i, mfem::Vector & trueX, mfem::Vector & trueRHS)
+{
+  auto & test_var_name = _test_var_names.at(i);
+  if (_assembly_level == mfem::AssemblyLevel::LEGACY)
+  {
+    if (!_combined_mats.Has(test_var_name))
+    {
+      EquationSystem::FormDiagonalBlock(i, trueX, trueRHS);
+      return;
+    }
+
+    // Assemble M + dt K in parallel and eliminate the essential DoFs, as
+    // ParBilinearForm::FormLinearSystem would for the matrix of the form. The
+    // result is kept until the sum is re-formed or the essential DoFs change.
+    auto * fespace = _test_pfespaces.at(i);
+    auto & ess_tdof_list = _ess_tdof_lists.at(i);
+    _combined_operators.resize(_test_var_names.size());
+    _combined_eliminated_operators.resize(_test_var_names.size());
+    _combined_ess_tdof_lists.resize(_test_var_names.size());
+    auto & combined_ess_tdof_list = _combined_ess_tdof_lists.at(i);
+    if (!_combined_operators.at(i) || !SameDofs(ess_tdof_list, combined_ess_tdof_list))
+    {
+      _combined_operators.at(i).reset(
+          _blfs.Get(test_var_name)->ParallelAssemble(_combined_mats.Get(test_var_name)));
+      _combined_eliminated_operators.at(i).reset(
+          _combined_operators.at(i)->EliminateRowsCols(ess_tdof_list));
+      combined_ess_tdof_list = ess_tdof_list;
+    }
+    auto & combined = *_combined_operators.at(i);
+    auto & combined_e = *_combined_eliminated_operators.at(i);
+
+    mfem::Vector aux_x(fespace->GetTrueVSize()), aux_rhs(fespace->GetTrueVSize());
+    fespace->GetRestrictionMatrix()->Mult(*(_xs.at(i)), aux_x);
+    aux_x.SetSubVectorComplement(ess_tdof_list, 0.0);
+    fespace->GetProlongationMatrix()->MultTranspose(*(_lfs.Get(test_var_name)), aux_rhs);
+    mfem::EliminateBC(combined, combined_e, ess_tdof_list, aux_x, aux_rhs);
+
+    if (_h_blocks(i, i) == nullptr)
+    {
+      _h_blocks(i, i) = new mfem::HypreParMatrix;
+    }
+    _h_blocks(i, i)->MakeRef(combined);
+    trueX = aux_x;
+    trueRHS = aux_rhs;
+    return;
+  }
+  if (!_dt_blfs.Has(test_var_name))
+  {
+    EquationSystem::FormDiagonalBlock(i, trueX, trueRHS);
+    return;
+  }
+
+  _unscaled_operators.resize(_test_var_names.size());
+  _dt_operators.resize(_test_var_names.size());
+
+  auto & ess_tdof_list = _ess_tdof_lists.at(i);
+  mfem::Vector aux_x, aux_rhs;
+  _blfs.Get(test_var_name)
+      ->FormLinearSystem(ess_tdof_list,
+                         *(_xs.at(i)),
+                         *(_lfs.Get(test_var_name)),
+                         _unscaled_operators.at(i),
+                         aux_x,
+                         aux_rhs);
+
+  // K only contributes the elimination of the essential DoFs to the RHS
+  mfem::ParLinearForm zero_lf(_test_pfespaces.at(i));
+  zero_lf = 0.0;
+  mfem::Vector dt_x, dt_rhs;
+  _dt_blfs.Get(test_var_name)
+      ->FormLinearSystem(
+          ess_tdof_list, *(_xs.at(i)), zero_lf, _dt_operators.at(i), dt_x, dt_rhs);
+  aux_rhs.Add(_dt_coef.constant, dt_rhs);
+
+  // Both constrained operators have unit diagonal entries on the essential
+  // DoFs, which the RHS above scales consistently.
+  _diagonal_operators.at(i).Reset(new mfem::SumOperator(_unscaled_operators.at(i).Ptr(),
+                                                        1.0,
+                                                        _dt_operators.at(i).Ptr(),
+                                                        _dt_coef.constant,
+                                                        false,
+                                                        false));
+  trueX = aux_x;
+  trueRHS = aux_rhs;
+}
+
+std::vector<std::pair<std::shared_ptr<mfem::ParBilinearForm>, double>>
+TimeDependentEquationSystem::GetBilinearFormTerms(const std::string & test_var_name)
+{
+  auto terms = EquationSystem::GetBilinearFormTerms(test_var_name);
+  if (_dt_blf_kernels_map.Has(test_var_name))
+  {
+    auto * fespace = terms.front().first->ParFESpace();
+    auto dt_blf = std::make_shared<mfem::ParBilinearForm>(fespace);
+    for (auto & blf_kernel : _dt_blf_kernels_map.GetRef(test_var_name))
+    {
+      blf_kernel->AddIntegrators(dt_blf.get());
+    }
+    terms.emplace_back(dt_blf, _dt_coef.constant);
+  }
+  return terms;
+}
+
 void
 TimeDependentEquationSystem::SetTimeStep(double dt)
 {
   if (fabs(dt - _dt_coef.constant) > 1.0e-12 * dt)
   {
     _dt_coef.constant = dt;
-    for (auto test_var_name : _test_var_names)
+    if (_operator_splitting)
+    {
+      // Only M + dt K is re-formed in UpdateEquationSystem
+      _recombine_blfs = true;
+    }
+    else
     {
-      auto blf = _blfs.Get(test_var_name);
-      blf->Update();
-      blf->Assemble();
+      MarkFormsDirty();
     }
   }
 }
@@ -60,6 +60,13 @@ public:
                  const std::string & test_var_name,
                  std::shared_ptr<ParMixedBilinearFormKernel> mblf_kernel);
 
+  // Form the off-diagonal block of the test/trial variable pair as scale times
+  // the transpose of the block of the trial/test pair, instead of assembling
+  // it from kernels. Use for pairs of adjoint mixed kernels.
+  void AddTransposedBlock(const std::string & trial_var_name,
+                          const std::string & test_var_name,
+                          double scale = 1.0);
+
   virtual void ApplyBoundaryConditions(hephaestus::BCMap & bc_map);
 
   // override to add kernels
@@ -75,11 +82,36 @@ public:
   virtual void BuildMixedBilinearForms();
   virtual void BuildEquationSystem(hephaestus::BCMap & bc_map, hephaestus::Sources & sources);
 
-  // Form linear system, with essential boundary conditions accounted for
+  // Flag all bilinear and mixed bilinear forms for reassembly on the next
+  // build. Forms are otherwise only rebuilt when one of their kernels is dirty.
+  virtual void MarkFormsDirty();
+
+  // Counters incremented whenever the values of the Jacobian may have changed
+  // (a form was reassembled), or its matrices were reallocated.
+  [[nodiscard]] long GetJacobianValuesSequence() const { return _jacobian_values_sequence; }
+  [[nodiscard]] long GetJacobianStructureSequence() const { return _jacobian_structure_sequence; }
+
+  // Form linear system, with essential boundary conditions accounted for. In
+  // persistent-sparsity mode, the monolithic matrix from a previous call is
+  // kept and only its values are overwritten if the block structure is unchanged.
+  // If the equation system is not monolithic, op is set to an
+  // mfem::BlockOperator of the individual blocks instead, which is likewise
+  // kept, with its blocks updated in place, if the block structure is unchanged.
   virtual void FormLinearSystem(mfem::OperatorHandle & op,
                                 mfem::BlockVector & trueX,
                                 mfem::BlockVector & trueRHS);
 
+  // Returns fresh, unassembled bilinear forms whose weighted sum is the
+  // bilinear form of the test variable. Used to build auxiliary discretisations,
+  // such as low-order refined preconditioners, for matrix-free operators.
+  virtual std::vector<std::pair<std::shared_ptr<mfem::ParBilinearForm>, double>>
+  GetBilinearFormTerms(const std::string & test_var_name);
+
+  [[nodiscard]] mfem::AssemblyLevel GetAssemblyLevel() const { return _assembly_level; }
+
+  // Returns the assembly level named by an "AssemblyLevel" parameter.
+  static mfem::AssemblyLevel ParseAssemblyLevel(const std::string & assembly_level_name);
+
   // Build linear system, with essential boundary conditions accounted for
   virtual void BuildJacobian(mfem::BlockVector & trueX, mfem::BlockVector & trueRHS);
 
@@ -99,6 +131,106 @@ protected:
   bool VectorContainsName(const std::vector<std::string> & the_vector,
                           const std::string & name) const;
 
+  // Returns true if the (mixed) bilinear form associated with the test (and
+  // trial) variable must be rebuilt before forming the linear system.
+  bool BilinearFormIsDirty(const std::string & test_var_name) const;
+  bool MixedBilinearFormIsDirty(const std::string & test_var_name,
+                                const std::string & trial_var_name) const;
+
+  // Mark all forms dirty if any test FE space has been updated (e.g. after a
+  // mesh change) since the forms were last built.
+  void CheckFESpaceSequences();
+
+  // Returns true if the essential true DoFs of the variable differ from
+  // ess_tdof_list, the list a form was last built with. MFEM eliminates the
+  // essential DoFs of a form only once, so such a form must be rebuilt.
+  bool EssentialDofsChanged(const std::string & var_name,
+                            const mfem::Array<int> & ess_tdof_list) const;
+
+  long _jacobian_values_sequence{0};
+  long _jacobian_structure_sequence{0};
+
+  bool _rebuild_blfs{true};
+  bool _rebuild_mblfs{true};
+  std::vector<long> _fespace_sequences;
+
+  // Essential true DoFs of the test (and trial) variables that each bilinear
+  // (and mixed bilinear) form was last built with
+  std::map<std::string, mfem::Array<int>> _blf_ess_tdof_lists;
+  std::map<std::pair<std::string, std::string>, std::pair<mfem::Array<int>, mfem::Array<int>>>
+      _mblf_ess_tdof_lists;
+
+  // Delete the block matrices stored in _h_blocks.
+  void DeleteBlocks();
+
+  // Returns true if the Jacobian held by op, monolithic or block, was built by
+  // this equation system with the current FE spaces and essential DoFs. Its
+  // blocks are then kept and updated in place.
+  bool CanReuseJacobianStructure(const mfem::OperatorHandle & op) const;
+
+  // Record the Jacobian built with the current FE spaces and essential DoFs.
+  void RecordJacobianStructure(const mfem::Operator * jacobian);
+
+  // Record where the entries of each block are stored in the monolithic matrix.
+  void BuildMonolithicValueMaps(mfem::HypreParMatrix & monolithic);
+
+  // Copy the values of the current blocks into the monolithic matrix. Returns
+  // false if the sparsity of a block no longer matches the recorded maps.
+  bool UpdateMonolithicValues(mfem::HypreParMatrix & monolithic);
+
+  // Positions of the entries of a block's local diagonal and off-diagonal
+  // parts in the monolithic matrix. Non-negative positions index the diagonal
+  // part of the monolithic matrix, negative positions p index its off-diagonal
+  // part at -(p + 1).
+  struct BlockValueMap
+  {
+    std::vector<int> _diag_positions;
+    std::vector<int> _offd_positions;
+  };
+
+  // Form the diagonal block of the i-th test variable, with essential
+  // boundary conditions accounted for, and its true DoF vectors.
+  virtual void FormDiagonalBlock(int i, mfem::Vector & trueX, mfem::Vector & trueRHS);
+
+  // Assembly level of the bilinear forms. If not LEGACY, the diagonal blocks
+  // are applied matrix-free and stored in _diagonal_operators.
+  mfem::AssemblyLevel _assembly_level{mfem::AssemblyLevel::LEGACY};
+  std::vector<mfem::OperatorHandle> _diagonal_operators;
+
+  // Merge blocks into a single HypreParMatrix. If false, the Jacobian is an
+  // mfem::BlockOperator for use with block preconditioners.
+  bool _monolithic{true};
+  mfem::Array<int> _block_offsets;
+
+  bool _persistent_sparsity{true};
+  const mfem::Operator * _jacobian_operator{nullptr};
+  std::vector<long> _jacobian_fespace_sequences;
+  std::vector<mfem::Array<int>> _jacobian_ess_tdof_lists;
+  std::map<std::pair<int, int>, BlockValueMap> _block_value_maps;
+
+  // Scale factors of the off-diagonal blocks formed by transposition, named
+  // according to their test and trial variables
+  std::map<std::pair<std::string, std::string>, double> _transposed_blocks;
+
+  // Local matrices of the mixed forms that the transposed blocks are formed
+  // from, copied on assembly. MFEM frees the matrix of a mixed form once its
+  // eliminated block has been formed, but the rows of the essential DoFs that
+  // it drops are needed for the right hand side of the transposed block.
+  std::map<std::pair<std::string, std::string>, std::unique_ptr<mfem::SparseMatrix>>
+      _transposed_source_mats;
+
+  // Transposed blocks, referenced by _h_blocks so that the block objects, and
+  // any preconditioner set up with them, persist between calls
+  std::map<std::pair<std::string, std::string>, std::unique_ptr<mfem::HypreParMatrix>>
+      _transposed_block_mats;
+
+  // Form the off-diagonal blocks formed by transposition, and add the
+  // contribution of the essential DoFs of their trial variables to trueRHS.
+  void FormTransposedBlocks(mfem::BlockVector & trueRHS);
+
+  // Assembled operators shared between kernels
+  hephaestus::OperatorRegistry _operators;
+
   // gridfunctions for setting Dirichlet BCs
   std::vector<std::unique_ptr<mfem::ParGridFunction>> _xs;
 
@@ -135,10 +267,64 @@ public:
 
   void AddTrialVariableNameIfMissing(const std::string & trial_var_name) override;
 
+  // Add a kernel whose contribution to the bilinear form of the test variable
+  // is multiplied by the time step. The kernel should not include dt itself.
+  void AddTimeStepScaledKernel(const std::string & test_var_name,
+                               std::shared_ptr<ParBilinearFormKernel> blf_kernel);
+
+  void Init(hephaestus::GridFunctions & gridfunctions,
+            const hephaestus::FESpaces & fespaces,
+            hephaestus::BCMap & bc_map,
+            hephaestus::Coefficients & coefficients) override;
+
+  // Build the bilinear forms as M + dt K, where M and K are assembled from the
+  // unscaled and time step scaled kernels respectively.
+  void BuildBilinearForms() override;
+
+  // Returns the unscaled terms and the time step scaled terms, weighted by dt.
+  std::vector<std::pair<std::shared_ptr<mfem::ParBilinearForm>, double>>
+  GetBilinearFormTerms(const std::string & test_var_name) override;
+
   virtual void SetTimeStep(double dt);
   virtual void UpdateEquationSystem(hephaestus::BCMap & bc_map, hephaestus::Sources & sources);
   mfem::ConstantCoefficient _dt_coef; // Coefficient for timestep scaling
   std::vector<std::string> _trial_var_time_derivative_names;
+
+protected:
+  // Returns true if the time step scaled part of the bilinear form associated
+  // with the test variable must be reassembled.
+  bool TimeStepScaledFormIsDirty(const std::string & test_var_name) const;
+
+  // Form the diagonal block from M + dt K. Fully assembled blocks are formed
+  // from the summed matrix, matrix-free blocks as a sum of operators.
+  void FormDiagonalBlock(int i, mfem::Vector & trueX, mfem::Vector & trueRHS) override;
+
+  // If true, M and K are kept when the time step changes, and only their sum
+  // is re-formed. Otherwise, all forms are reassembled.
+  bool _operator_splitting{true};
+  bool _recombine_blfs{true};
+
+  hephaestus::NamedFieldsMap<std::vector<std::shared_ptr<ParBilinearFormKernel>>>
+      _dt_blf_kernels_map;
+
+  // Time step scaled parts (K) of each bilinear form. The unscaled parts (M)
+  // are held in _blfs.
+  hephaestus::NamedFieldsMap<mfem::ParBilinearForm> _dt_blfs;
+
+  // Sums M + dt K of fully assembled forms, owned separately so that the forms
+  // themselves are left untouched
+  hephaestus::NamedFieldsMap<mfem::SparseMatrix> _combined_mats;
+
+  // Parallel assembled, eliminated sums and their eliminated parts, with the
+  // essential DoFs they were eliminated for. Cleared whenever the sum is
+  // re-formed, and otherwise reused between calls to FormLinearSystem.
+  std::vector<std::unique_ptr<mfem::HypreParMatrix>> _combined_operators;
+  std::vector<std::unique_ptr<mfem::HypreParMatrix>> _combined_eliminated_operators;
+  std::vector<mfem::Array<int>> _combined_ess_tdof_lists;
+
+  // Constrained matrix-free M and K operators, summed in _diagonal_operators
+  std::vector<mfem::OperatorHandle> _unscaled_operators;
+  std::vector<mfem::OperatorHandle> _dt_operators;
 };
 
 } // namespace hephaestus
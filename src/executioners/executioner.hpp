@@ -1,3 +1,4 @@
 #pragma once
+#include "frequency_sweep_executioner.hpp"
 #include "steady_executioner.hpp"
 #include "transient_executioner.hpp"
@@ -0,0 +1,295 @@
+#include "frequency_sweep_executioner.hpp"
+
+namespace hephaestus
+{
+
+namespace
+{
+
+// y += c w for complex c and block vectors [real; imag]
+void
+AddComplex(std::complex<double> c, const mfem::Vector & w, mfem::Vector & y)
+{
+  const int n = w.Size() / 2;
+  for (int i = 0; i < n; i++)
+  {
+    const double w_r = w(i);
+    const double w_i = w(i + n);
+    y(i) += c.real() * w_r - c.imag() * w_i;
+    y(i + n) += c.real() * w_i + c.imag() * w_r;
+  }
+}
+
+void
+ZeroEssentialEntries(const mfem::Array<int> & ess_tdofs, mfem::Vector & v)
+{
+  const int n = v.Size() / 2;
+  for (int tdof : ess_tdofs)
+  {
+    v(tdof) = 0.0;
+    v(tdof + n) = 0.0;
+  }
+}
+
+} // namespace
+
+FrequencySweepExecutioner::FrequencySweepExecutioner(const hephaestus::InputParameters & params)
+  : Executioner(params),
+    _problem(params.GetParam<hephaestus::SteadyStateProblem *>("Problem")),
+    _frequencies(params.GetParam<std::vector<double>>("Frequencies")),
+    _frequency_coef_name(
+        params.GetOptionalParam<std::string>("FrequencyCoefName", std::string("frequency"))),
+    _tolerance(params.GetOptionalParam<float>("ReducedBasisTolerance", 1.0e-6)),
+    _max_basis_size(params.GetOptionalParam<unsigned int>("MaxReducedBasisSize", 20))
+{
+}
+
+hephaestus::ComplexMaxwellOperator *
+FrequencySweepExecutioner::GetComplexOperator() const
+{
+  auto * complex_operator =
+      dynamic_cast<hephaestus::ComplexMaxwellOperator *>(_problem->GetOperator());
+  if (!complex_operator)
+  {
+    MFEM_ABORT("FrequencySweepExecutioner requires a ComplexMaxwellOperator.");
+  }
+  return complex_operator;
+}
+
+void
+FrequencySweepExecutioner::SetFrequency(double frequency) const
+{
+  _frequency = frequency;
+
+  auto & coefficients = _problem->_coefficients;
+  coefficients._scalars.Get<mfem::ConstantCoefficient>(_frequency_coef_name)->constant = frequency;
+  coefficients.MarkChanged(_frequency_coef_name);
+
+  const double omega = 2.0 * M_PI * frequency;
+  const std::map<std::string, double> derived_constants = {
+      {"_angular_frequency", omega},
+      {"_neg_angular_frequency", -omega},
+      {"_angular_frequency_sq", omega * omega},
+      {"_neg_angular_frequency_sq", -omega * omega}};
+  for (const auto & [name, value] : derived_constants)
+  {
+    if (coefficients._scalars.Has(name))
+    {
+      coefficients._scalars.Get<mfem::ConstantCoefficient>(name)->constant = value;
+      coefficients.MarkChanged(name);
+    }
+  }
+}
+
+std::complex<double>
+FrequencySweepExecutioner::Dot(const mfem::Vector & u, const mfem::Vector & v) const
+{
+  // uᴴv for block vectors [real; imag]
+  const int n = u.Size() / 2;
+  auto & u_ref = const_cast<mfem::Vector &>(u);
+  auto & v_ref = const_cast<mfem::Vector &>(v);
+  mfem::Vector u_r(u_ref, 0, n), u_i(u_ref, n, n);
+  mfem::Vector v_r(v_ref, 0, n), v_i(v_ref, n, n);
+
+  const double real = mfem::InnerProduct(_problem->_comm, u_r, v_r) +
+                      mfem::InnerProduct(_problem->_comm, u_i, v_i);
+  const double imag = mfem::InnerProduct(_problem->_comm, u_r, v_i) -
+                      mfem::InnerProduct(_problem->_comm, u_i, v_r);
+  return {real, imag};
+}
+
+bool
+FrequencySweepExecutioner::ReducedSolve(const mfem::Vector & f,
+                                        const mfem::Vector & x_bc,
+                                        mfem::Vector & x) const
+{
+  const int k = _basis.size();
+  if (k == 0)
+  {
+    return false;
+  }
+
+  const double ratio = _frequency / _reference_frequency;
+  const double ratio_sq = ratio * ratio;
+
+  // (Vᴴ A(ω) V) y = Vᴴ f in real-equivalent form
+  mfem::DenseMatrix a_reduced(2 * k);
+  mfem::Vector f_reduced(2 * k), y(2 * k);
+  for (int i = 0; i < k; i++)
+  {
+    for (int j = 0; j < k; j++)
+    {
+      const auto a_ij = _a0_reduced[i][j] + ratio_sq * _m_reduced[i][j] + ratio * _l_reduced[i][j];
+      a_reduced(i, j) = a_ij.real();
+      a_reduced(i, j + k) = -a_ij.imag();
+      a_reduced(i + k, j) = a_ij.imag();
+      a_reduced(i + k, j + k) = a_ij.real();
+    }
+    const auto f_i = Dot(_basis[i], f);
+    f_reduced(i) = f_i.real();
+    f_reduced(i + k) = f_i.imag();
+  }
+  mfem::DenseMatrixInverse a_reduced_inv(a_reduced);
+  a_reduced_inv.Mult(f_reduced, y);
+
+  // Error indicator: relative residual of the reduced solution, evaluated from
+  // the stored images of the basis without further matrix products.
+  mfem::Vector residual(f);
+  for (int j = 0; j < k; j++)
+  {
+    const std::complex<double> y_j(y(j), y(j + k));
+    AddComplex(-y_j, _a0_basis[j], residual);
+    AddComplex(-ratio_sq * y_j, _m_basis[j], residual);
+    AddComplex(-ratio * y_j, _l_basis[j], residual);
+  }
+  ZeroEssentialEntries(GetComplexOperator()->_ess_bdr_tdofs, residual);
+
+  const double f_norm = std::sqrt(Dot(f, f).real());
+  const double error = (f_norm > 0.0) ? std::sqrt(Dot(residual, residual).real()) / f_norm : 0.0;
+  logger.info("FrequencySweepExecutioner: f = {}, reduced basis size {}, estimated error {}",
+              _frequency,
+              k,
+              error);
+  if (error > _tolerance)
+  {
+    return false;
+  }
+
+  x = x_bc;
+  for (int j = 0; j < k; j++)
+  {
+    AddComplex(std::complex<double>(y(j), y(j + k)), _basis[j], x);
+  }
+  return true;
+}
+
+void
+FrequencySweepExecutioner::AddToBasis(mfem::Vector v) const
+{
+  auto * complex_operator = GetComplexOperator();
+  ZeroEssentialEntries(complex_operator->_ess_bdr_tdofs, v);
+
+  // Orthonormalise against the basis, with one reorthogonalisation pass
+  const double initial_norm = std::sqrt(Dot(v, v).real());
+  for (int pass = 0; pass < 2; pass++)
+  {
+    for (const auto & basis_vector : _basis)
+    {
+      AddComplex(-Dot(basis_vector, v), basis_vector, v);
+    }
+  }
+  const double norm = std::sqrt(Dot(v, v).real());
+  if (norm <= 1.0e-12 * initial_norm || norm == 0.0)
+  {
+    return;
+  }
+  v /= norm;
+
+  mfem::Vector a0v, mv, lv;
+  complex_operator->MultFrequencyTerms(v, a0v, mv, lv);
+
+  // Extend the reduced matrices by one row and column
+  const int k = _basis.size();
+  auto extend = [&](std::vector<std::vector<std::complex<double>>> & reduced,
+                    const std::vector<mfem::Vector> & images,
+                    const mfem::Vector & image)
+  {
+    for (int i = 0; i < k; i++)
+    {
+      reduced[i].push_back(Dot(_basis[i], image));
+    }
+    reduced.emplace_back(k + 1);
+    for (int j = 0; j < k; j++)
+    {
+      reduced[k][j] = Dot(v, images[j]);
+    }
+    reduced[k][k] = Dot(v, image);
+  };
+  extend(_a0_reduced, _a0_basis, a0v);
+  extend(_m_reduced, _m_basis, mv);
+  extend(_l_reduced, _l_basis, lv);
+
+  _basis.push_back(std::move(v));
+  _a0_basis.push_back(std::move(a0v));
+  _m_basis.push_back(std::move(mv));
+  _l_basis.push_back(std::move(lv));
+}
+
+void
+FrequencySweepExecutioner::Solve() const
+{
+  auto * complex_operator = GetComplexOperator();
+  _problem->_preprocessors.Solve();
+  complex_operator->CheckFrequencyDecomposition();
+
+  // f = b - A(ω) x_bc, restricted to non-essential true dofs
+  mfem::Vector b, x_bc, a0x, mx, lx;
+  complex_operator->FormFrequencyRHS(b, x_bc);
+  complex_operator->MultFrequencyTerms(x_bc, a0x, mx, lx);
+
+  const double ratio = _frequency / _reference_frequency;
+  mfem::Vector f(b);
+  f.Add(-1.0, a0x);
+  f.Add(-ratio * ratio, mx);
+  f.Add(-ratio, lx);
+  ZeroEssentialEntries(complex_operator->_ess_bdr_tdofs, f);
+
+  mfem::Vector x;
+  if (ReducedSolve(f, x_bc, x))
+  {
+    complex_operator->SetTrueSolution(x);
+    _num_reduced_solves++;
+  }
+  else
+  {
+    complex_operator->Solve(*(_problem->_f));
+    _num_full_solves++;
+
+    if (_basis.size() < _max_basis_size)
+    {
+      complex_operator->GetTrueSolution(x);
+      x -= x_bc;
+      AddToBasis(x);
+    }
+  }
+  _problem->_postprocessors.Solve();
+
+  // Output data, indexed by frequency
+  _problem->_outputs.Write(_frequency);
+}
+
+void
+FrequencySweepExecutioner::Execute() const
+{
+  MFEM_VERIFY(!_frequencies.empty(), "FrequencySweepExecutioner: no frequencies given.");
+  MFEM_VERIFY(_frequencies.front() > 0.0,
+              "FrequencySweepExecutioner: the first frequency must be positive.");
+
+  _basis.clear();
+  _a0_basis.clear();
+  _m_basis.clear();
+  _l_basis.clear();
+  _a0_reduced.clear();
+  _m_reduced.clear();
+  _l_reduced.clear();
+  _num_full_solves = 0;
+  _num_reduced_solves = 0;
+
+  // The frequency decomposition is assembled once, at the first frequency
+  SetFrequency(_frequencies.front());
+  _reference_frequency = _frequency;
+  GetComplexOperator()->AssembleFrequencyDecomposition();
+
+  for (double frequency : _frequencies)
+  {
+    SetFrequency(frequency);
+    Solve();
+  }
+
+  logger.info("FrequencySweepExecutioner: {} full and {} reduced solves over {} frequencies",
+              _num_full_solves,
+              _num_reduced_solves,
+              _frequencies.size());
+}
+
+} // namespace hephaestus
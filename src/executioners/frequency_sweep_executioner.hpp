@@ -0,0 +1,68 @@
+#pragma once
+#include "complex_maxwell_formulation.hpp"
+#include "executioner_base.hpp"
+#include "steady_state_problem_builder.hpp"
+#include <complex>
+
+namespace hephaestus
+{
+
+// Solves a complex Maxwell problem over a list of frequencies. The curl-curl,
+// mass and loss matrices are assembled once at the first frequency; at each
+// subsequent frequency the solution is first sought by Galerkin projection onto
+// a reduced basis of previous full solutions. If the relative residual of the
+// reduced solution exceeds "ReducedBasisTolerance", a full solve is performed
+// and its solution is added to the basis.
+class FrequencySweepExecutioner : public Executioner
+{
+public:
+  FrequencySweepExecutioner() = default;
+  explicit FrequencySweepExecutioner(const hephaestus::InputParameters & params);
+
+  // Solve at the current frequency
+  void Solve() const override;
+
+  // Sweep over all frequencies
+  void Execute() const override;
+
+  // Number of full and reduced solves in the last sweep
+  [[nodiscard]] int GetNumFullSolves() const { return _num_full_solves; }
+  [[nodiscard]] int GetNumReducedSolves() const { return _num_reduced_solves; }
+
+  hephaestus::SteadyStateProblem * _problem{nullptr};
+
+private:
+  // Updates the frequency coefficients registered by ComplexMaxwellFormulation.
+  void SetFrequency(double frequency) const;
+
+  // Attempts a solve in the reduced basis. Returns false if the estimated
+  // relative error is above the tolerance.
+  bool ReducedSolve(const mfem::Vector & f, const mfem::Vector & x_bc, mfem::Vector & x) const;
+
+  // Adds the homogeneous part of a full solution to the reduced basis.
+  void AddToBasis(mfem::Vector v) const;
+
+  [[nodiscard]] std::complex<double> Dot(const mfem::Vector & u, const mfem::Vector & v) const;
+
+  hephaestus::ComplexMaxwellOperator * GetComplexOperator() const;
+
+  std::vector<double> _frequencies;
+  std::string _frequency_coef_name;
+  double _tolerance;
+  unsigned int _max_basis_size;
+
+  mutable double _frequency{0.0};
+  mutable double _reference_frequency{0.0};
+
+  // Reduced basis, orthonormal and zero on essential true dofs, and the images
+  // of each basis vector under the terms of the frequency decomposition.
+  mutable std::vector<mfem::Vector> _basis, _a0_basis, _m_basis, _l_basis;
+
+  // Reduced matrices Vᴴ A₀ V, Vᴴ M V and Vᴴ (iL) V.
+  mutable std::vector<std::vector<std::complex<double>>> _a0_reduced, _m_reduced, _l_reduced;
+
+  mutable int _num_full_solves{0};
+  mutable int _num_reduced_solves{0};
+};
+
+} // namespace hephaestus
@@ -54,12 +54,62 @@ AVFormulation::ConstructEquationSystem()
   av_system_params.SetParam("ScalarPotentialName", _scalar_potential_name);
   av_system_params.SetParam("AlphaCoefName", _alpha_coef_name);
   av_system_params.SetParam("BetaCoefName", _beta_coef_name);
+  av_system_params.SetParam("Monolithic", GetBlockPreconditionerName() == "None");
 
   auto equation_system = std::make_unique<hephaestus::AVEquationSystem>(av_system_params);
 
   GetProblem()->GetOperator()->SetEquationSystem(std::move(equation_system));
 }
 
+std::string
+AVFormulation::GetBlockPreconditionerName()
+{
+  const auto name =
+      GetProblem()->_solver_options.GetOptionalParam<std::string>("BlockPreconditioner", "None");
+  if (name != "None" && name != "Diagonal" && name != "LowerTriangular")
+  {
+    MFEM_ABORT("Unknown BlockPreconditioner " << name
+                                              << "; expected None, Diagonal or LowerTriangular.");
+  }
+  return name;
+}
+
+void
+AVFormulation::ConstructJacobianPreconditioner()
+{
+  const auto block_preconditioner_name = GetBlockPreconditionerName();
+  if (block_preconditioner_name == "None")
+  {
+    TimeDomainEMFormulation::ConstructJacobianPreconditioner();
+    return;
+  }
+
+  // AMS on the H(curl) block and BoomerAMG on the H1 block
+  const auto structure = (block_preconditioner_name == "Diagonal")
+                             ? HCurlH1BlockPreconditioner::Structure::DIAGONAL
+                             : HCurlH1BlockPreconditioner::Structure::LOWER_TRIANGULAR;
+  const auto print_level =
+      GetProblem()->_solver_options.GetOptionalParam<int>("PrintLevel", logger.level());
+  auto precond = std::make_shared<hephaestus::HCurlH1BlockPreconditioner>(
+      _problem->GetEquationSystem()->_test_pfespaces.at(0), structure, print_level);
+
+  GetProblem()->_jacobian_preconditioner = precond;
+}
+
+void
+AVFormulation::ConstructJacobianSolver()
+{
+  // Hypre Krylov solvers require a monolithic HypreParMatrix
+  if (GetBlockPreconditionerName() == "None")
+  {
+    ConstructJacobianSolverWithOptions(SolverType::HYPRE_GMRES);
+  }
+  else
+  {
+    ConstructJacobianSolverWithOptions(SolverType::GMRES);
+  }
+}
+
 void
 AVFormulation::RegisterGridFunctions()
 {
@@ -113,6 +163,7 @@ AVFormulation::RegisterCoefficients()
       _alpha_coef_name,
       std::make_shared<mfem::TransformedCoefficient>(
           &_one_coef, coefficients._scalars.Get(_inv_alpha_coef_name), fracFunc));
+  coefficients.SetDependencies(_alpha_coef_name, {_inv_alpha_coef_name});
 }
 
 AVEquationSystem::AVEquationSystem(const hephaestus::InputParameters & params)
@@ -121,7 +172,6 @@ AVEquationSystem::AVEquationSystem(const hephaestus::InputParameters & params)
     _v_name(params.GetParam<std::string>("ScalarPotentialName")),
     _alpha_coef_name(params.GetParam<std::string>("AlphaCoefName")),
     _beta_coef_name(params.GetParam<std::string>("BetaCoefName")),
-    _dtalpha_coef_name(std::string("dt_") + _alpha_coef_name),
     _neg_beta_coef_name(std::string("negative_") + _beta_coef_name),
     _neg_coef(-1.0)
 {
@@ -133,15 +183,11 @@ AVEquationSystem::Init(hephaestus::GridFunctions & gridfunctions,
                        hephaestus::BCMap & bc_map,
                        hephaestus::Coefficients & coefficients)
 {
-  coefficients._scalars.Register(
-      _dtalpha_coef_name,
-      std::make_shared<mfem::TransformedCoefficient>(
-          &_dt_coef, coefficients._scalars.Get(_alpha_coef_name), prodFunc));
-
   coefficients._scalars.Register(
       _neg_beta_coef_name,
       std::make_shared<mfem::TransformedCoefficient>(
           &_neg_coef, coefficients._scalars.Get(_beta_coef_name), prodFunc));
+  coefficients.SetDependencies(_neg_beta_coef_name, {_beta_coef_name});
 
   TimeDependentEquationSystem::Init(gridfunctions, fespaces, bc_map, coefficients);
 }
@@ -164,8 +210,9 @@ AVEquationSystem::AddKernels()
 
   // (αdt∇×dA/dt_{n+1}, ∇×dA'/dt)
   hephaestus::InputParameters curl_curl_params;
-  curl_curl_params.SetParam("CoefficientName", _dtalpha_coef_name);
-  AddKernel(da_dt_name, std::make_shared<hephaestus::CurlCurlKernel>(curl_curl_params));
+  curl_curl_params.SetParam("CoefficientName", _alpha_coef_name);
+  AddTimeStepScaledKernel(da_dt_name,
+                          std::make_shared<hephaestus::CurlCurlKernel>(curl_curl_params));
 
   // (βdA/dt_{n+1}, dA'/dt)
   hephaestus::InputParameters vector_fe_mass_params;
@@ -184,13 +231,8 @@ AVEquationSystem::AddKernels()
   diffusion_params.SetParam("CoefficientName", _beta_coef_name);
   AddKernel(_v_name, std::make_shared<hephaestus::DiffusionKernel>(diffusion_params));
 
-  // (σdA/dt, ∇ V')
-  hephaestus::InputParameters vector_fe_weak_divergence_params;
-  vector_fe_weak_divergence_params.SetParam("CoefficientName", _beta_coef_name);
-  AddKernel(
-      da_dt_name,
-      _v_name,
-      std::make_shared<hephaestus::VectorFEWeakDivergenceKernel>(vector_fe_weak_divergence_params));
+  // -(σdA/dt, ∇ V'), the negative transpose of (σ ∇ V, dA'/dt)
+  AddTransposedBlock(da_dt_name, _v_name, -1.0);
 
   logger.info("{} AddKernels: {} seconds", typeid(this).name(), sw);
 }
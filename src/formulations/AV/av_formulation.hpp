@@ -20,11 +20,20 @@ public:
 
   void ConstructEquationSystem() override;
 
+  void ConstructJacobianPreconditioner() override;
+
+  void ConstructJacobianSolver() override;
+
   void RegisterGridFunctions() override;
 
   void RegisterCoefficients() override;
 
 protected:
+  // Block preconditioner selected with the "BlockPreconditioner" solver
+  // option: "Diagonal" or "LowerTriangular". Defaults to "None", which merges
+  // the A and V blocks into a single matrix preconditioned with BoomerAMG.
+  std::string GetBlockPreconditionerName();
+
   const std::string _alpha_coef_name;
   const std::string _inv_alpha_coef_name;
   const std::string _beta_coef_name;
@@ -46,7 +55,7 @@ public:
   void AddKernels() override;
 
   std::string _a_name, _v_name, _coupled_variable_name, _alpha_coef_name, _beta_coef_name,
-      _dtalpha_coef_name, _neg_beta_coef_name;
+      _neg_beta_coef_name;
   mfem::ConstantCoefficient _neg_coef;
 };
 
@@ -24,10 +24,47 @@ ComplexMaxwellFormulation::ComplexMaxwellFormulation(std::string alpha_coef_name
 {
 }
 
+std::string
+ComplexMaxwellFormulation::GetComplexSolverName()
+{
+  const auto name =
+      GetProblem()->_solver_options.GetOptionalParam<std::string>("ComplexSolver", "Direct");
+  if (name != "Direct" && name != "Iterative")
+  {
+    MFEM_ABORT("Unknown ComplexSolver " << name << "; expected Direct or Iterative.");
+  }
+  return name;
+}
+
+void
+ComplexMaxwellFormulation::ConstructJacobianPreconditioner()
+{
+  if (GetComplexSolverName() == "Direct")
+  {
+    FrequencyDomainEMFormulation::ConstructJacobianPreconditioner();
+    return;
+  }
+
+  auto * edge_fespace = GetProblem()->_gridfunctions.Get(_h_curl_var_real_name)->ParFESpace();
+  const auto print_level =
+      GetProblem()->_solver_options.GetOptionalParam<int>("PrintLevel", logger.level());
+  auto precond = std::make_shared<hephaestus::ComplexHCurlBlockPreconditioner>(
+      edge_fespace, mfem::ComplexOperator::HERMITIAN, print_level);
+
+  GetProblem()->_jacobian_preconditioner = precond;
+}
+
 void
 ComplexMaxwellFormulation::ConstructJacobianSolver()
 {
-  ConstructJacobianSolverWithOptions(SolverType::SUPER_LU);
+  if (GetComplexSolverName() == "Direct")
+  {
+    ConstructJacobianSolverWithOptions(SolverType::SUPER_LU);
+  }
+  else
+  {
+    ConstructJacobianSolverWithOptions(SolverType::GMRES);
+  }
 }
 
 void
@@ -112,17 +149,20 @@ ComplexMaxwellFormulation::RegisterCoefficients()
                                      coefficients._scalars.Get("_neg_angular_frequency_sq"),
                                      coefficients._scalars.Get(_zeta_coef_name),
                                      prodFunc));
+  coefficients.SetDependencies(_mass_coef_name, {"_neg_angular_frequency_sq", _zeta_coef_name});
 
   coefficients._scalars.Register(_loss_coef_name,
                                  std::make_shared<mfem::TransformedCoefficient>(
                                      coefficients._scalars.Get("_angular_frequency"),
                                      coefficients._scalars.Get(_beta_coef_name),
                                      prodFunc));
+  coefficients.SetDependencies(_loss_coef_name, {"_angular_frequency", _beta_coef_name});
 
   coefficients._scalars.Register(
       _alpha_coef_name,
       std::make_shared<mfem::TransformedCoefficient>(
           &_one_coef, coefficients._scalars.Get("magnetic_permeability"), fracFunc));
+  coefficients.SetDependencies(_alpha_coef_name, {"magnetic_permeability"});
 }
 
 ComplexMaxwellOperator::ComplexMaxwellOperator(hephaestus::Problem & problem,
@@ -165,6 +205,192 @@ ComplexMaxwellOperator::Init(mfem::Vector & X)
     _mass_coef = _problem._coefficients._scalars.Get(_mass_coef_name);
   if (_problem._coefficients._scalars.Has(_loss_coef_name))
     _loss_coef = _problem._coefficients._scalars.Get(_loss_coef_name);
+
+  if (_mass_coef)
+    _abs_mass_coef = std::make_unique<mfem::TransformedCoefficient>(_mass_coef, absFunc);
+  if (_loss_coef)
+    _abs_loss_coef = std::make_unique<mfem::TransformedCoefficient>(_loss_coef, absFunc);
+}
+
+std::unique_ptr<mfem::HypreParMatrix>
+ComplexMaxwellOperator::AssembleAuxiliaryMatrix()
+{
+  mfem::ParBilinearForm aux_form(_u->ParFESpace());
+  aux_form.AddDomainIntegrator(new mfem::CurlCurlIntegrator(*_stiff_coef));
+  if (_abs_mass_coef)
+  {
+    aux_form.AddDomainIntegrator(new mfem::VectorFEMassIntegrator(*_abs_mass_coef));
+  }
+  if (_abs_loss_coef)
+  {
+    aux_form.AddDomainIntegrator(new mfem::VectorFEMassIntegrator(*_abs_loss_coef));
+  }
+  aux_form.Assemble();
+  aux_form.Finalize();
+
+  auto aux = std::make_unique<mfem::HypreParMatrix>();
+  aux_form.FormSystemMatrix(_ess_bdr_tdofs, *aux);
+  return aux;
+}
+
+void
+ComplexMaxwellOperator::AssembleLinearForm(mfem::ParComplexLinearForm & lf)
+{
+  mfem::ParLinearForm lf_real(_u->ParFESpace());
+  mfem::ParLinearForm lf_imag(_u->ParFESpace());
+  lf_real = 0.0;
+  lf_imag = 0.0;
+
+  _problem._sources.Apply(&lf_real);
+
+  _problem._bc_map.ApplyEssentialBCs(
+      _h_curl_var_complex_name, _ess_bdr_tdofs, *_u, _problem._pmesh.get());
+  _problem._bc_map.ApplyIntegratedBCs(_h_curl_var_complex_name, lf, _problem._pmesh.get());
+
+  lf.Assemble();
+  lf.real() += lf_real;
+  lf.imag() += lf_imag;
+}
+
+std::unique_ptr<mfem::ComplexHypreParMatrix>
+ComplexMaxwellOperator::AssembleBoundaryMatrix()
+{
+  mfem::ParSesquilinearForm boundary(_u->ParFESpace(), _conv);
+  _problem._bc_map.ApplyIntegratedBCs(_h_curl_var_complex_name, boundary, _problem._pmesh.get());
+  boundary.Assemble();
+  boundary.Finalize();
+  return std::unique_ptr<mfem::ComplexHypreParMatrix>(boundary.ParallelAssemble());
+}
+
+void
+ComplexMaxwellOperator::AssembleFrequencyDecomposition()
+{
+  // MultFrequencyTerms applies the terms as complex products
+  MFEM_VERIFY(_conv == mfem::ComplexOperator::HERMITIAN,
+              "The frequency decomposition requires the HERMITIAN convention.");
+
+  _boundary_matrix = AssembleBoundaryMatrix();
+
+  mfem::ParSesquilinearForm a0(_u->ParFESpace(), _conv);
+  a0.AddDomainIntegrator(new mfem::CurlCurlIntegrator(*_stiff_coef), nullptr);
+  _problem._bc_map.ApplyIntegratedBCs(_h_curl_var_complex_name, a0, _problem._pmesh.get());
+  a0.Assemble();
+  a0.Finalize();
+  _stiffness_matrix.reset(a0.ParallelAssemble());
+
+  _mass_matrix.reset();
+  if (_mass_coef)
+  {
+    mfem::ParBilinearForm mass(_u->ParFESpace());
+    mass.AddDomainIntegrator(new mfem::VectorFEMassIntegrator(*_mass_coef));
+    mass.Assemble();
+    mass.Finalize();
+    _mass_matrix.reset(mass.ParallelAssemble());
+  }
+
+  _loss_matrix.reset();
+  if (_loss_coef)
+  {
+    mfem::ParBilinearForm loss(_u->ParFESpace());
+    loss.AddDomainIntegrator(new mfem::VectorFEMassIntegrator(*_loss_coef));
+    loss.Assemble();
+    loss.Finalize();
+    _loss_matrix.reset(loss.ParallelAssemble());
+  }
+}
+
+void
+ComplexMaxwellOperator::CheckFrequencyDecomposition()
+{
+  MFEM_VERIFY(_boundary_matrix, "Frequency decomposition has not been assembled.");
+  auto boundary_matrix = AssembleBoundaryMatrix();
+
+  auto relative_difference = [](const mfem::HypreParMatrix & a, const mfem::HypreParMatrix & b)
+  {
+    std::unique_ptr<mfem::HypreParMatrix> difference(mfem::Add(1.0, a, -1.0, b));
+    const double norm = std::max(a.FNorm(), b.FNorm());
+    return (norm > 0.0) ? difference->FNorm() / norm : 0.0;
+  };
+  const double real_difference =
+      relative_difference(boundary_matrix->real(), _boundary_matrix->real());
+  const double imag_difference =
+      relative_difference(boundary_matrix->imag(), _boundary_matrix->imag());
+  MFEM_VERIFY(std::max(real_difference, imag_difference) < 1.0e-12,
+              "Integrated boundary conditions of "
+                  << _h_curl_var_complex_name
+                  << " depend on the frequency; the frequency decomposition does not apply.");
+}
+
+void
+ComplexMaxwellOperator::MultFrequencyTerms(const mfem::Vector & x,
+                                           mfem::Vector & a0x,
+                                           mfem::Vector & mx,
+                                           mfem::Vector & lx) const
+{
+  MFEM_VERIFY(_stiffness_matrix, "Frequency decomposition has not been assembled.");
+  const int n = x.Size() / 2;
+  mfem::Vector x_r, x_i;
+  x_r.MakeRef(const_cast<mfem::Vector &>(x), 0, n);
+  x_i.MakeRef(const_cast<mfem::Vector &>(x), n, n);
+
+  a0x.SetSize(2 * n);
+  _stiffness_matrix->Mult(x, a0x);
+
+  mx.SetSize(2 * n);
+  mx = 0.0;
+  if (_mass_matrix)
+  {
+    mfem::Vector mx_r(mx, 0, n), mx_i(mx, n, n);
+    _mass_matrix->Mult(x_r, mx_r);
+    _mass_matrix->Mult(x_i, mx_i);
+  }
+
+  // iL(x_r + ix_i) = -Lx_i + iLx_r
+  lx.SetSize(2 * n);
+  lx = 0.0;
+  if (_loss_matrix)
+  {
+    mfem::Vector lx_r(lx, 0, n), lx_i(lx, n, n);
+    _loss_matrix->Mult(x_i, lx_r);
+    lx_r.Neg();
+    _loss_matrix->Mult(x_r, lx_i);
+  }
+}
+
+void
+ComplexMaxwellOperator::FormFrequencyRHS(mfem::Vector & b, mfem::Vector & x_bc)
+{
+  mfem::ParComplexLinearForm lf(_u->ParFESpace(), _conv);
+  AssembleLinearForm(lf);
+
+  const int n = _u->ParFESpace()->GetTrueVSize();
+  b.SetSize(2 * n);
+  lf.ParallelAssemble(b);
+
+  mfem::Vector u_true(2 * n);
+  _u->ParallelProject(u_true);
+  x_bc.SetSize(2 * n);
+  x_bc = 0.0;
+  for (int tdof : _ess_bdr_tdofs)
+  {
+    x_bc(tdof) = u_true(tdof);
+    x_bc(tdof + n) = u_true(tdof + n);
+  }
+}
+
+void
+ComplexMaxwellOperator::GetTrueSolution(mfem::Vector & x) const
+{
+  x.SetSize(2 * _u->ParFESpace()->GetTrueVSize());
+  _u->ParallelProject(x);
+}
+
+void
+ComplexMaxwellOperator::SetTrueSolution(const mfem::Vector & x)
+{
+  _u->Distribute(&x);
+  _problem._gridfunctions.GetRef(_trial_var_names.at(0)) = _u->real();
+  _problem._gridfunctions.GetRef(_trial_var_names.at(1)) = _u->imag();
 }
 
 void
@@ -189,32 +415,38 @@ ComplexMaxwellOperator::Solve(mfem::Vector & X)
     sqlf.AddDomainIntegrator(nullptr, new mfem::VectorFEMassIntegrator(*_loss_coef));
   }
 
-  mfem::ParLinearForm lf_real(_u->ParFESpace());
-  mfem::ParLinearForm lf_imag(_u->ParFESpace());
-  lf_real = 0.0;
-  lf_imag = 0.0;
-
-  _problem._sources.Apply(&lf_real);
-
   mfem::ParComplexLinearForm lf(_u->ParFESpace(), _conv);
-  _problem._bc_map.ApplyEssentialBCs(
-      _h_curl_var_complex_name, _ess_bdr_tdofs, *_u, _problem._pmesh.get());
-  _problem._bc_map.ApplyIntegratedBCs(_h_curl_var_complex_name, lf, _problem._pmesh.get());
+  AssembleLinearForm(lf);
   _problem._bc_map.ApplyIntegratedBCs(_h_curl_var_complex_name, sqlf, _problem._pmesh.get());
 
   sqlf.Assemble();
   sqlf.Finalize();
 
-  lf.Assemble();
-  lf.real() += lf_real;
-  lf.imag() += lf_imag;
-
   sqlf.FormLinearSystem(_ess_bdr_tdofs, *_u, lf, jac, u, rhs);
 
-  auto * jac_z = jac.As<mfem::ComplexHypreParMatrix>()->GetSystemMatrix();
+  auto block_preconditioner =
+      std::dynamic_pointer_cast<hephaestus::ComplexHCurlBlockPreconditioner>(
+          _problem._jacobian_preconditioner);
+  if (block_preconditioner)
+  {
+    // Iterative solve on the 2×2 real block system
+    block_preconditioner->SetAuxiliaryMatrix(AssembleAuxiliaryMatrix());
 
-  _problem._jacobian_solver->SetOperator(*jac_z);
-  _problem._jacobian_solver->Mult(rhs, u);
+    _problem._jacobian_solver->SetOperator(*jac);
+    _problem._jacobian_solver->Mult(rhs, u);
+    logger.info("ComplexMaxwellOperator: iterative solve took {} iterations",
+                GetNumIterations(*_problem._jacobian_solver));
+  }
+  else
+  {
+    // The SuperLU solver only refactorizes if the assembled system has changed
+    // since the last solve.
+    std::unique_ptr<mfem::HypreParMatrix> jac_z(
+        jac.As<mfem::ComplexHypreParMatrix>()->GetSystemMatrix());
+
+    _problem._jacobian_solver->SetOperator(*jac_z);
+    _problem._jacobian_solver->Mult(rhs, u);
+  }
   sqlf.RecoverFEMSolution(u, lf, *_u);
 
   _problem._gridfunctions.GetRef(_trial_var_names.at(0)) = _u->real();
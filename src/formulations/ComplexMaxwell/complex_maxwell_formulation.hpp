@@ -38,6 +38,8 @@ public:
 
   ~ComplexMaxwellFormulation() override = default;
 
+  void ConstructJacobianPreconditioner() override;
+
   void ConstructJacobianSolver() override;
 
   void ConstructOperator() override;
@@ -48,6 +50,12 @@ public:
 
   // std::vector<mfem::ParGridFunction *> local_trial_vars, local_test_vars;
 protected:
+  // Solver for the complex system selected with the "ComplexSolver" solver
+  // option: "Direct" (default) factorizes the real-equivalent matrix with
+  // SuperLU; "Iterative" uses GMRES on the 2×2 real block system with an AMS
+  // block-diagonal preconditioner.
+  std::string GetComplexSolverName();
+
   const std::string _alpha_coef_name;
   const std::string _beta_coef_name;
   const std::string _zeta_coef_name;
@@ -76,6 +84,30 @@ public:
   void Init(mfem::Vector & X) override;
   void Solve(mfem::Vector & X) override;
 
+  // Frequency sweep support. The unconstrained true-dof system is decomposed
+  // as A(ω) = A₀ + (ω/ω₀)² M + i(ω/ω₀) L, assembled once at the current
+  // frequency ω₀: A₀ holds the curl-curl and integrated boundary terms, M the
+  // mass term and L the loss term. Vectors are ordered [real; imag]. Requires
+  // the HERMITIAN convention.
+  void AssembleFrequencyDecomposition();
+
+  // Aborts if the integrated boundary terms at the current coefficients differ
+  // from those assembled into A₀, i.e. if they depend on the frequency.
+  void CheckFrequencyDecomposition();
+
+  // Applies the terms of the decomposition to x: a0x = A₀x, mx = Mx, lx = iLx.
+  void MultFrequencyTerms(const mfem::Vector & x,
+                          mfem::Vector & a0x,
+                          mfem::Vector & mx,
+                          mfem::Vector & lx) const;
+
+  // Assembles the true-dof load vector at the current coefficients, and the
+  // essential boundary values (zero away from essential true dofs).
+  void FormFrequencyRHS(mfem::Vector & b, mfem::Vector & x_bc);
+
+  void GetTrueSolution(mfem::Vector & x) const;
+  void SetTrueSolution(const mfem::Vector & x);
+
   std::string _h_curl_var_complex_name, _h_curl_var_real_name, _h_curl_var_imag_name,
       _stiffness_coef_name, _mass_coef_name, _loss_coef_name;
 
@@ -87,6 +119,25 @@ public:
   mfem::Coefficient * _loss_coef{nullptr};  // omega sigma
 
   mfem::Array<int> _ess_bdr_tdofs;
+
+protected:
+  // Sources and integrated boundary conditions; also applies essential
+  // boundary conditions to _u.
+  void AssembleLinearForm(mfem::ParComplexLinearForm & lf);
+
+  // Positive-definite auxiliary matrix for ComplexHCurlBlockPreconditioner
+  std::unique_ptr<mfem::HypreParMatrix> AssembleAuxiliaryMatrix();
+
+  // Integrated boundary terms of the system matrix at the current coefficients
+  std::unique_ptr<mfem::ComplexHypreParMatrix> AssembleBoundaryMatrix();
+
+  std::unique_ptr<mfem::TransformedCoefficient> _abs_mass_coef{nullptr};
+  std::unique_ptr<mfem::TransformedCoefficient> _abs_loss_coef{nullptr};
+
+  std::unique_ptr<mfem::ComplexHypreParMatrix> _stiffness_matrix{nullptr};
+  std::unique_ptr<mfem::ComplexHypreParMatrix> _boundary_matrix{nullptr};
+  std::unique_ptr<mfem::HypreParMatrix> _mass_matrix{nullptr};
+  std::unique_ptr<mfem::HypreParMatrix> _loss_matrix{nullptr};
 };
 
 } // namespace hephaestus
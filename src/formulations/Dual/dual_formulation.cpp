@@ -150,24 +150,10 @@ WeakCurlEquationSystem::WeakCurlEquationSystem(const hephaestus::InputParameters
     _h_curl_var_name(params.GetParam<std::string>("HCurlVarName")),
     _h_div_var_name(params.GetParam<std::string>("HDivVarName")),
     _alpha_coef_name(params.GetParam<std::string>("AlphaCoefName")),
-    _beta_coef_name(params.GetParam<std::string>("BetaCoefName")),
-    _dtalpha_coef_name(std::string("dt_") + _alpha_coef_name)
+    _beta_coef_name(params.GetParam<std::string>("BetaCoefName"))
 {
 }
 
-void
-WeakCurlEquationSystem::Init(hephaestus::GridFunctions & gridfunctions,
-                             const hephaestus::FESpaces & fespaces,
-                             hephaestus::BCMap & bc_map,
-                             hephaestus::Coefficients & coefficients)
-{
-  coefficients._scalars.Register(
-      _dtalpha_coef_name,
-      std::make_shared<mfem::TransformedCoefficient>(
-          &_dt_coef, coefficients._scalars.Get(_alpha_coef_name), prodFunc));
-  TimeDependentEquationSystem::Init(gridfunctions, fespaces, bc_map, coefficients);
-}
-
 void
 WeakCurlEquationSystem::AddKernels()
 {
@@ -186,8 +172,9 @@ WeakCurlEquationSystem::AddKernels()
 
   // (αdt∇×u_{n+1}, ∇×u')
   hephaestus::InputParameters curl_curl_params;
-  curl_curl_params.SetParam("CoefficientName", _dtalpha_coef_name);
-  AddKernel(_h_curl_var_name, std::make_shared<hephaestus::CurlCurlKernel>(curl_curl_params));
+  curl_curl_params.SetParam("CoefficientName", _alpha_coef_name);
+  AddTimeStepScaledKernel(_h_curl_var_name,
+                          std::make_shared<hephaestus::CurlCurlKernel>(curl_curl_params));
 
   // (βu_{n+1}, u')
   hephaestus::InputParameters vector_fe_mass_params;
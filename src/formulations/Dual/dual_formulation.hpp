@@ -41,14 +41,9 @@ public:
   WeakCurlEquationSystem(const hephaestus::InputParameters & params);
   ~WeakCurlEquationSystem() override = default;
 
-  void Init(hephaestus::GridFunctions & gridfunctions,
-            const hephaestus::FESpaces & fespaces,
-            hephaestus::BCMap & bc_map,
-            hephaestus::Coefficients & coefficients) override;
   void AddKernels() override;
 
-  std::string _h_curl_var_name, _h_div_var_name, _alpha_coef_name, _beta_coef_name,
-      _dtalpha_coef_name;
+  std::string _h_curl_var_name, _h_div_var_name, _alpha_coef_name, _beta_coef_name;
 };
 
 class DualOperator : public TimeDomainProblemOperator
@@ -125,6 +125,7 @@ HFormulation::RegisterCoefficients()
       _electric_resistivity_name,
       std::make_shared<mfem::TransformedCoefficient>(
           &_one_coef, coefficients._scalars.Get(_electric_conductivity_name), fracFunc));
+  coefficients.SetDependencies(_electric_resistivity_name, {_electric_conductivity_name});
   HCurlFormulation::RegisterCoefficients();
 }
 
@@ -59,15 +59,45 @@ HCurlFormulation::ConstructEquationSystem()
   weak_form_params.SetParam("HCurlVarName", _h_curl_var_name);
   weak_form_params.SetParam("AlphaCoefName", _alpha_coef_name);
   weak_form_params.SetParam("BetaCoefName", _beta_coef_name);
+  weak_form_params.SetParam("AssemblyLevel", GetAssemblyLevelName());
 
   auto equation_system = std::make_unique<hephaestus::CurlCurlEquationSystem>(weak_form_params);
 
   GetProblem()->GetOperator()->SetEquationSystem(std::move(equation_system));
 }
 
+std::string
+HCurlFormulation::GetAssemblyLevelName()
+{
+  return GetProblem()->_solver_options.GetOptionalParam<std::string>("AssemblyLevel", "Full");
+}
+
+bool
+HCurlFormulation::UseLORPreconditioner()
+{
+  return GetAssemblyLevelName() != "Full" ||
+         GetProblem()->_solver_options.GetOptionalParam<bool>("LORPreconditioner", false);
+}
+
 void
 HCurlFormulation::ConstructJacobianPreconditioner()
 {
+  if (UseLORPreconditioner())
+  {
+    auto * equation_system = _problem->GetEquationSystem();
+    const auto & var_name = equation_system->_test_var_names.at(0);
+    auto precond = std::make_shared<hephaestus::LORPreconditioner>(
+        equation_system->_test_pfespaces.at(0),
+        [equation_system, var_name]() { return equation_system->GetBilinearFormTerms(var_name); },
+        [equation_system]() -> const mfem::Array<int> &
+        { return equation_system->_ess_tdof_lists.at(0); },
+        -1,
+        true);
+
+    GetProblem()->_jacobian_preconditioner = precond;
+    return;
+  }
+
   auto precond =
       std::make_shared<mfem::HypreAMS>(_problem->GetEquationSystem()->_test_pfespaces.at(0));
 
@@ -80,7 +110,10 @@ HCurlFormulation::ConstructJacobianPreconditioner()
 void
 HCurlFormulation::ConstructJacobianSolver()
 {
-  ConstructJacobianSolverWithOptions(SolverType::HYPRE_PCG);
+  // Hypre Krylov solvers require an assembled HypreParMatrix and a Hypre
+  // preconditioner
+  ConstructJacobianSolverWithOptions(UseLORPreconditioner() ? SolverType::PCG
+                                                            : SolverType::HYPRE_PCG);
 }
 
 void
@@ -109,22 +142,8 @@ CurlCurlEquationSystem::CurlCurlEquationSystem(const hephaestus::InputParameters
   : TimeDependentEquationSystem(params),
     _h_curl_var_name(params.GetParam<std::string>("HCurlVarName")),
     _alpha_coef_name(params.GetParam<std::string>("AlphaCoefName")),
-    _beta_coef_name(params.GetParam<std::string>("BetaCoefName")),
-    _dtalpha_coef_name(std::string("dt_") + _alpha_coef_name)
-{
-}
-
-void
-CurlCurlEquationSystem::Init(hephaestus::GridFunctions & gridfunctions,
-                             const hephaestus::FESpaces & fespaces,
-                             hephaestus::BCMap & bc_map,
-                             hephaestus::Coefficients & coefficients)
+    _beta_coef_name(params.GetParam<std::string>("BetaCoefName"))
 {
-  coefficients._scalars.Register(
-      _dtalpha_coef_name,
-      std::make_shared<mfem::TransformedCoefficient>(
-          &_dt_coef, coefficients._scalars.Get(_alpha_coef_name), prodFunc));
-  TimeDependentEquationSystem::Init(gridfunctions, fespaces, bc_map, coefficients);
 }
 
 void
@@ -144,8 +163,9 @@ CurlCurlEquationSystem::AddKernels()
 
   // (αdt∇×du/dt_{n+1}, ∇×u')
   hephaestus::InputParameters curl_curl_params;
-  curl_curl_params.SetParam("CoefficientName", _dtalpha_coef_name);
-  AddKernel(dh_curl_var_dt, std::make_shared<hephaestus::CurlCurlKernel>(curl_curl_params));
+  curl_curl_params.SetParam("CoefficientName", _alpha_coef_name);
+  AddTimeStepScaledKernel(dh_curl_var_dt,
+                          std::make_shared<hephaestus::CurlCurlKernel>(curl_curl_params));
 
   // (βdu/dt_{n+1}, u')
   hephaestus::InputParameters vector_fe_mass_params;
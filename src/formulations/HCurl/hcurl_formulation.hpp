@@ -27,6 +27,15 @@ public:
   void RegisterCoefficients() override;
 
 protected:
+  // Returns the "AssemblyLevel" solver option. If not "Full", the Jacobian is
+  // applied matrix-free and preconditioned with a low-order refined AMS solver.
+  std::string GetAssemblyLevelName();
+
+  // Returns true if the Jacobian is preconditioned with AMS on its low-order
+  // refined counterpart: if the "LORPreconditioner" solver option is set, or
+  // if the Jacobian is matrix-free.
+  bool UseLORPreconditioner();
+
   const std::string _alpha_coef_name;
   const std::string _beta_coef_name;
   const std::string _h_curl_var_name;
@@ -37,13 +46,9 @@ class CurlCurlEquationSystem : public TimeDependentEquationSystem
 public:
   CurlCurlEquationSystem(const hephaestus::InputParameters & params);
 
-  void Init(hephaestus::GridFunctions & gridfunctions,
-            const hephaestus::FESpaces & fespaces,
-            hephaestus::BCMap & bc_map,
-            hephaestus::Coefficients & coefficients) override;
   void AddKernels() override;
 
-  std::string _h_curl_var_name, _alpha_coef_name, _beta_coef_name, _dtalpha_coef_name;
+  std::string _h_curl_var_name, _alpha_coef_name, _beta_coef_name;
 };
 
 } // namespace hephaestus
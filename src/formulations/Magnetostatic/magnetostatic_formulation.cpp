@@ -80,5 +80,6 @@ MagnetostaticFormulation::RegisterCoefficients()
       _magnetic_reluctivity_name,
       std::make_shared<mfem::TransformedCoefficient>(
           &_one_coef, coefficients._scalars.Get(_magnetic_permeability_name), fracFunc));
+  coefficients.SetDependencies(_magnetic_reluctivity_name, {_magnetic_permeability_name});
 }
 } // namespace hephaestus
@@ -37,9 +37,35 @@ StaticsFormulation::StaticsFormulation(std::string alpha_coef_name, std::string
 {
 }
 
+bool
+StaticsFormulation::UseLORPreconditioner()
+{
+  const auto & solver_options = GetProblem()->_solver_options;
+  return solver_options.GetOptionalParam<std::string>("AssemblyLevel", "Full") != "Full" ||
+         solver_options.GetOptionalParam<bool>("LORPreconditioner", false);
+}
+
 void
 StaticsFormulation::ConstructJacobianPreconditioner()
 {
+  if (UseLORPreconditioner())
+  {
+    // AMS on the low-order refined curl-curl matrix
+    auto * statics_operator = dynamic_cast<hephaestus::StaticsOperator *>(_problem->GetOperator());
+    MFEM_VERIFY(statics_operator != nullptr,
+                "LORPreconditioner requires the operator to be a StaticsOperator.");
+    auto precond = std::make_shared<hephaestus::LORPreconditioner>(
+        _problem->_gridfunctions.Get(_h_curl_var_name)->ParFESpace(),
+        [statics_operator]() { return statics_operator->GetBilinearFormTerms(); },
+        [statics_operator]() -> const mfem::Array<int> &
+        { return statics_operator->GetEssentialTrueDofs(); },
+        -1,
+        true);
+
+    _problem->_jacobian_preconditioner = precond;
+    return;
+  }
+
   std::shared_ptr<mfem::HypreAMS> precond{std::make_shared<mfem::HypreAMS>(
       _problem->_gridfunctions.Get(_h_curl_var_name)->ParFESpace())};
 
@@ -52,8 +78,10 @@ StaticsFormulation::ConstructJacobianPreconditioner()
 void
 StaticsFormulation::ConstructJacobianSolver()
 {
-  ConstructJacobianSolverWithOptions(SolverType::HYPRE_FGMRES,
-                                     {._max_iteration = 100, ._k_dim = 10});
+  // Hypre Krylov solvers require an assembled HypreParMatrix and a Hypre
+  // preconditioner
+  ConstructJacobianSolverWithOptions(UseLORPreconditioner() ? SolverType::GMRES
+                                                            : SolverType::HYPRE_FGMRES);
 }
 
 void
@@ -116,6 +144,16 @@ StaticsOperator::Init(mfem::Vector & X)
 {
   ProblemOperator::Init(X);
   _stiff_coef = _problem._coefficients._scalars.Get(_stiffness_coef_name);
+  _assembly_level = hephaestus::EquationSystem::ParseAssemblyLevel(
+      _problem._solver_options.GetOptionalParam<std::string>("AssemblyLevel", "Full"));
+}
+
+std::vector<std::pair<std::shared_ptr<mfem::ParBilinearForm>, double>>
+StaticsOperator::GetBilinearFormTerms()
+{
+  auto blf = std::make_shared<mfem::ParBilinearForm>(_trial_variables.at(0)->ParFESpace());
+  blf->AddDomainIntegrator(new mfem::CurlCurlIntegrator(*_stiff_coef));
+  return {{blf, 1.0}};
 }
 
 /*
@@ -137,23 +175,23 @@ StaticsOperator::Solve(mfem::Vector & X)
   gf = 0.0;
   mfem::ParLinearForm lf(gf.ParFESpace());
   lf = 0.0;
-  mfem::Array<int> ess_bdr_tdofs;
-  _problem._bc_map.ApplyEssentialBCs(_h_curl_var_name, ess_bdr_tdofs, gf, _problem._pmesh.get());
+  _problem._bc_map.ApplyEssentialBCs(_h_curl_var_name, _ess_bdr_tdofs, gf, _problem._pmesh.get());
   _problem._bc_map.ApplyIntegratedBCs(_h_curl_var_name, lf, _problem._pmesh.get());
   lf.Assemble();
   _problem._sources.Apply(&lf);
   mfem::ParBilinearForm blf(gf.ParFESpace());
+  blf.SetAssemblyLevel(_assembly_level);
   blf.AddDomainIntegrator(new mfem::CurlCurlIntegrator(*_stiff_coef));
   blf.Assemble();
   blf.Finalize();
-  mfem::HypreParMatrix curl_mu_inv_curl;
+  mfem::OperatorHandle curl_mu_inv_curl(mfem::Operator::Hypre_ParCSR);
   mfem::HypreParVector sol_tdofs(gf.ParFESpace());
   mfem::HypreParVector rhs_tdofs(gf.ParFESpace());
-  blf.FormLinearSystem(ess_bdr_tdofs, gf, lf, curl_mu_inv_curl, sol_tdofs, rhs_tdofs);
+  blf.FormLinearSystem(_ess_bdr_tdofs, gf, lf, curl_mu_inv_curl, sol_tdofs, rhs_tdofs);
 
   // Define and apply a parallel FGMRES solver for AX=B with the AMS
-  // preconditioner from hypre.
-  _problem._jacobian_solver->SetOperator(curl_mu_inv_curl);
+  // preconditioner from hypre, or a GMRES solver with the LOR preconditioner.
+  _problem._jacobian_solver->SetOperator(*curl_mu_inv_curl);
   _problem._jacobian_solver->Mult(rhs_tdofs, sol_tdofs);
   blf.RecoverFEMSolution(sol_tdofs, lf, gf);
 
@@ -25,6 +25,10 @@ public:
   void RegisterCoefficients() override;
 
 protected:
+  // Returns true if the "LORPreconditioner" solver option is set, or if the
+  // "AssemblyLevel" solver option makes the Jacobian matrix-free.
+  bool UseLORPreconditioner();
+
   const std::string _alpha_coef_name;
   const std::string _h_curl_var_name;
 };
@@ -42,10 +46,20 @@ public:
   void Init(mfem::Vector & X) override;
   void Solve(mfem::Vector & X) override;
 
+  // Returns a fresh, unassembled curl-curl form, to build auxiliary
+  // discretisations such as low-order refined preconditioners.
+  std::vector<std::pair<std::shared_ptr<mfem::ParBilinearForm>, double>> GetBilinearFormTerms();
+
+  // Essential true DoFs of the last solve
+  [[nodiscard]] const mfem::Array<int> & GetEssentialTrueDofs() const { return _ess_bdr_tdofs; }
+
 private:
   std::string _h_curl_var_name, _stiffness_coef_name;
 
   mfem::Coefficient * _stiff_coef{nullptr}; // Stiffness Material Coefficient
+
+  mfem::AssemblyLevel _assembly_level{mfem::AssemblyLevel::LEGACY};
+  mfem::Array<int> _ess_bdr_tdofs;
 };
 
 } // namespace hephaestus
@@ -82,13 +82,224 @@ TimeDomainProblemOperator::ImplicitSolve(const double dt,
   _problem._coefficients.SetTime(GetTime());
   BuildEquationSystemOperator(dt);
 
-  _problem._nonlinear_solver->SetSolver(*_problem._jacobian_solver);
-  _problem._nonlinear_solver->SetOperator(*GetEquationSystem());
-  _problem._nonlinear_solver->Mult(_true_rhs, _true_x);
+  const auto & solver_options = _problem._solver_options;
+  auto initial_guess = solver_options.GetOptionalParam<std::string>("InitialGuess", "None");
+  if (initial_guess == "Projection" && !HasPCGJacobianSolver())
+  {
+    // The projection minimises the error in the A-norm, which requires a
+    // symmetric positive definite Jacobian
+    if (!_warned_projection_fallback)
+    {
+      logger.warn("InitialGuess Projection requires a PCG Jacobian solver; using Quadratic.");
+      _warned_projection_fallback = true;
+    }
+    initial_guess = "Quadratic";
+  }
+  if (initial_guess == "None")
+  {
+    _problem._nonlinear_solver->SetSolver(GetReusableJacobianSolver());
+    _problem._nonlinear_solver->SetOperator(*GetEquationSystem());
+    _problem._nonlinear_solver->Mult(_true_rhs, _true_x);
+  }
+  else
+  {
+    // The equation system is linear, so solve it directly from the
+    // extrapolated guess; the Newton update would otherwise start the Krylov
+    // solve for the correction from zero.
+    ExtrapolateInitialGuess(initial_guess, GetTime());
+
+    auto & jacobian_solver = GetReusableJacobianSolver();
+    jacobian_solver.SetOperator(GetEquationSystem()->GetGradient(_true_x));
+    jacobian_solver.iterative_mode = true;
+    jacobian_solver.Mult(_true_rhs, _true_x);
+
+    const auto max_history = (initial_guess == "Projection")
+                                 ? solver_options.GetOptionalParam<unsigned int>(
+                                       "InitialGuessHistory", 5)
+                                 : 3;
+    UpdateSolutionHistory(GetTime(), max_history);
+  }
 
   GetEquationSystem()->RecoverFEMSolution(_true_x, _problem._gridfunctions);
 }
 
+void
+TimeDomainProblemOperator::ExtrapolateInitialGuess(const std::string & method, double time)
+{
+  // Discard history from a differently sized system
+  if (!_previous_solutions.empty() && _previous_solutions.front().Size() != _true_x.Size())
+  {
+    _previous_solutions.clear();
+    _previous_solution_times.clear();
+  }
+  if (_previous_solutions.empty())
+  {
+    return;
+  }
+
+  // Dirichlet values set by FormLinearSystem are kept
+  const mfem::Vector dirichlet_x(_true_x);
+  mfem::Vector guess(_true_x.Size());
+  guess = 0.0;
+
+  if (method == "Linear" || method == "Quadratic")
+  {
+    // Lagrange extrapolation through the most recent solutions
+    std::size_t num_points = std::min<std::size_t>(method == "Linear" ? 2 : 3,
+                                                   _previous_solutions.size());
+    for (std::size_t i = 0; i < num_points; i++)
+    {
+      for (std::size_t j = 0; j < i; j++)
+      {
+        if (_previous_solution_times[i] == _previous_solution_times[j])
+        {
+          num_points = 1;
+        }
+      }
+    }
+
+    for (std::size_t i = 0; i < num_points; i++)
+    {
+      double weight = 1.0;
+      for (std::size_t j = 0; j < num_points; j++)
+      {
+        if (j != i)
+        {
+          weight *= (time - _previous_solution_times[j]) /
+                    (_previous_solution_times[i] - _previous_solution_times[j]);
+        }
+      }
+      guess.Add(weight, _previous_solutions[i]);
+    }
+  }
+  else if (method == "Projection")
+  {
+    // Build an A-orthonormal basis of the previous solutions with modified
+    // Gram-Schmidt and project the solution onto it: for symmetric positive
+    // definite A, this minimises the A-norm of the initial error.
+    auto * equation_system = GetEquationSystem();
+    std::vector<mfem::Vector> basis, a_basis;
+    for (const auto & previous_solution : _previous_solutions)
+    {
+      mfem::Vector v(previous_solution), a_v(v.Size());
+      equation_system->Mult(v, a_v);
+      const double initial_norm = std::sqrt(std::abs(mfem::InnerProduct(_problem._comm, v, a_v)));
+
+      for (std::size_t j = 0; j < basis.size(); j++)
+      {
+        const double alpha = mfem::InnerProduct(_problem._comm, a_basis[j], v);
+        v.Add(-alpha, basis[j]);
+        a_v.Add(-alpha, a_basis[j]);
+      }
+
+      // Drop (nearly) linearly dependent solutions
+      const double norm = std::sqrt(std::abs(mfem::InnerProduct(_problem._comm, v, a_v)));
+      if (norm <= 1.0e-10 * initial_norm || norm == 0.0)
+      {
+        continue;
+      }
+      v /= norm;
+      a_v /= norm;
+      basis.push_back(std::move(v));
+      a_basis.push_back(std::move(a_v));
+    }
+
+    for (const auto & q : basis)
+    {
+      guess.Add(mfem::InnerProduct(_problem._comm, q, _true_rhs), q);
+    }
+  }
+  else
+  {
+    MFEM_ABORT("Unknown InitialGuess " << method
+                                       << "; expected None, Linear, Quadratic or Projection.");
+  }
+
+  // Restore Dirichlet values
+  _true_x.Set(1.0, guess);
+  const auto & ess_tdof_lists = GetEquationSystem()->_ess_tdof_lists;
+  for (std::size_t i = 0; i < ess_tdof_lists.size(); i++)
+  {
+    for (const int tdof : ess_tdof_lists[i])
+    {
+      const int index = _block_true_offsets[i] + tdof;
+      _true_x(index) = dirichlet_x(index);
+    }
+  }
+}
+
+bool
+TimeDomainProblemOperator::HasPCGJacobianSolver() const
+{
+  const mfem::Solver * solver = _problem._jacobian_solver.get();
+  return dynamic_cast<const mfem::HyprePCG *>(solver) != nullptr ||
+         dynamic_cast<const mfem::CGSolver *>(solver) != nullptr ||
+         dynamic_cast<const hephaestus::RecyclingPCGSolver *>(solver) != nullptr;
+}
+
+void
+TimeDomainProblemOperator::UpdateSolutionHistory(double time, std::size_t max_history)
+{
+  _previous_solutions.emplace_front(_true_x);
+  _previous_solution_times.push_front(time);
+  while (_previous_solutions.size() > max_history)
+  {
+    _previous_solutions.pop_back();
+    _previous_solution_times.pop_back();
+  }
+}
+
+mfem::Solver &
+TimeDomainProblemOperator::GetReusableJacobianSolver()
+{
+  if (!_reusable_jacobian_solver ||
+      &_reusable_jacobian_solver->GetSolver() != _problem._jacobian_solver.get())
+  {
+    const auto & solver_options = _problem._solver_options;
+    const auto policy_name =
+        solver_options.GetOptionalParam<std::string>("PreconditionerReuse", "Always");
+    const auto iteration_ratio =
+        solver_options.GetOptionalParam<float>("PreconditionerReuseIterationRatio", 1.5);
+
+    ReusableJacobianSolver::ReusePolicy policy;
+    if (policy_name == "Always")
+    {
+      policy = ReusableJacobianSolver::ReusePolicy::ALWAYS_REBUILD;
+    }
+    else if (policy_name == "OnChange")
+    {
+      policy = ReusableJacobianSolver::ReusePolicy::REBUILD_ON_CHANGE;
+    }
+    else if (policy_name == "IterationThreshold")
+    {
+      policy = ReusableJacobianSolver::ReusePolicy::ITERATION_THRESHOLD;
+    }
+    else
+    {
+      MFEM_ABORT("Unknown PreconditionerReuse policy "
+                 << policy_name << "; expected Always, OnChange or IterationThreshold.");
+    }
+
+    _reusable_jacobian_solver = std::make_unique<hephaestus::ReusableJacobianSolver>(
+        _problem._jacobian_solver, policy, iteration_ratio);
+  }
+
+  // Inform the solver of changes to the Jacobian since the last solve
+  const auto * equation_system = GetEquationSystem();
+  if (equation_system->GetJacobianStructureSequence() != _jacobian_structure_sequence)
+  {
+    _reusable_jacobian_solver->MarkStructureChanged();
+    _jacobian_structure_sequence = equation_system->GetJacobianStructureSequence();
+  }
+  if (equation_system->GetJacobianValuesSequence() != _jacobian_values_sequence)
+  {
+    _reusable_jacobian_solver->MarkOperatorChanged();
+    _jacobian_values_sequence = equation_system->GetJacobianValuesSequence();
+  }
+
+  return *_reusable_jacobian_solver;
+}
+
 void
 TimeDomainProblemOperator::BuildEquationSystemOperator(double dt)
 {
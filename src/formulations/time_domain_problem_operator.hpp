@@ -3,6 +3,7 @@
 #include "hephaestus_solvers.hpp"
 #include "problem_builder_base.hpp"
 #include "problem_operator_interface.hpp"
+#include <deque>
 
 namespace hephaestus
 {
@@ -43,8 +44,35 @@ public:
   }
 
 protected:
+  // Returns the Jacobian solver wrapped to apply the preconditioner reuse
+  // policy set by the "PreconditionerReuse" solver option: "Always" (default),
+  // "OnChange" or "IterationThreshold" (with "PreconditionerReuseIterationRatio").
+  mfem::Solver & GetReusableJacobianSolver();
+
+  // Set the non-Dirichlet entries of _true_x to an initial guess extrapolated
+  // from previous solutions, as selected by the "InitialGuess" solver option:
+  // "Linear" or "Quadratic" (Lagrange extrapolation in time) or "Projection"
+  // (A-orthogonal projection onto the span of the last "InitialGuessHistory"
+  // solutions). "Projection" falls back to "Quadratic" unless the Jacobian
+  // solver is PCG-based.
+  void ExtrapolateInitialGuess(const std::string & method, double time);
+
+  // Whether the Jacobian solver assumes a symmetric positive definite operator.
+  [[nodiscard]] bool HasPCGJacobianSolver() const;
+
+  // Store the latest solution for use in later extrapolations.
+  void UpdateSolutionHistory(double time, std::size_t max_history);
+
   std::unique_ptr<TimeDependentEquationSystem> _equation_system{nullptr};
   std::vector<mfem::ParGridFunction *> _trial_variable_time_derivatives;
+
+  std::unique_ptr<hephaestus::ReusableJacobianSolver> _reusable_jacobian_solver{nullptr};
+  long _jacobian_values_sequence{-1};
+  long _jacobian_structure_sequence{-1};
+
+  std::deque<mfem::Vector> _previous_solutions;
+  std::deque<double> _previous_solution_times;
+  bool _warned_projection_fallback{false};
 };
 
 } // namespace hephaestus
\ No newline at end of file
@@ -15,10 +15,46 @@ CurlCurlKernel::Init(hephaestus::GridFunctions & gridfunctions,
                      hephaestus::Coefficients & coefficients)
 {
   _coef = coefficients._scalars.Get(_coef_name);
+  TrackCoefficient(coefficients, _coef_name);
+}
+
+mfem::ParBilinearForm &
+CurlCurlKernel::GetSharedForm(hephaestus::OperatorRegistry & operators,
+                              mfem::ParFiniteElementSpace & fespace,
+                              const std::string & coef_name,
+                              mfem::Coefficient & coef,
+                              long state)
+{
+  return operators.GetForm("CurlCurl(" + coef_name + ")",
+                           fespace,
+                           state,
+                           [&coef](mfem::ParBilinearForm & form)
+                           { form.AddDomainIntegrator(new mfem::CurlCurlIntegrator(coef)); });
 }
 
 void
 CurlCurlKernel::Apply(mfem::ParBilinearForm * blf)
+{
+  // Assembled matrices can only be shared between fully assembled forms
+  if (_operators == nullptr || blf->GetAssemblyLevel() != mfem::AssemblyLevel::LEGACY)
+  {
+    AddIntegrators(blf);
+  }
+}
+
+void
+CurlCurlKernel::ApplyAssembled(mfem::ParBilinearForm * blf)
+{
+  if (_operators != nullptr && blf->GetAssemblyLevel() == mfem::AssemblyLevel::LEGACY)
+  {
+    auto & curl_curl = GetSharedForm(
+        *_operators, *blf->ParFESpace(), _coef_name, *_coef, TrackedCoefficientsState());
+    blf->SpMat().Add(1.0, curl_curl.SpMat());
+  }
+}
+
+void
+CurlCurlKernel::AddIntegrators(mfem::ParBilinearForm * blf)
 {
   blf->AddDomainIntegrator(new mfem::CurlCurlIntegrator(*_coef));
 }
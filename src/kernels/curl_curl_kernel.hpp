@@ -6,6 +6,10 @@ namespace hephaestus
 
 /*
 (α∇×u, ∇×u')
+
+If the kernel belongs to an equation system with fully assembled forms, the
+form is assembled once in the equation system's OperatorRegistry, where it is
+shared with the WeakCurlCurlKernels using the same coefficient.
 */
 class CurlCurlKernel : public Kernel<mfem::ParBilinearForm>
 {
@@ -19,6 +23,17 @@ public:
             hephaestus::BCMap & bc_map,
             hephaestus::Coefficients & coefficients) override;
   void Apply(mfem::ParBilinearForm * blf) override;
+  void ApplyAssembled(mfem::ParBilinearForm * blf) override;
+  void AddIntegrators(mfem::ParBilinearForm * blf) override;
+
+  // Returns the curl-curl form with coefficient coef on fespace from the
+  // registry, reassembling it if state has changed.
+  static mfem::ParBilinearForm & GetSharedForm(hephaestus::OperatorRegistry & operators,
+                                               mfem::ParFiniteElementSpace & fespace,
+                                               const std::string & coef_name,
+                                               mfem::Coefficient & coef,
+                                               long state);
+
   std::string _coef_name;
   mfem::Coefficient * _coef{nullptr};
 };
@@ -15,6 +15,7 @@ DiffusionKernel::Init(hephaestus::GridFunctions & gridfunctions,
                       hephaestus::Coefficients & coefficients)
 {
   _coef = coefficients._scalars.Get(_coef_name);
+  TrackCoefficient(coefficients, _coef_name);
 }
 
 void
@@ -3,6 +3,7 @@
 #include "coefficients.hpp"
 #include "hephaestus_solvers.hpp"
 #include "inputs.hpp"
+#include "operator_registry.hpp"
 
 namespace hephaestus
 {
@@ -23,6 +24,81 @@ public:
   }
 
   virtual void Apply(T * form) = 0;
+
+  // Called after the form has been assembled and before it is finalized, to
+  // add contributions that have been assembled elsewhere, such as operators
+  // shared through the OperatorRegistry.
+  virtual void ApplyAssembled(T * form) {}
+
+  // Adds all integrators of this kernel to form, including those of
+  // contributions added through ApplyAssembled. Used to build auxiliary
+  // discretizations from the kernels, such as low-order-refined
+  // preconditioners.
+  virtual void AddIntegrators(T * form) { Apply(form); }
+
+  // Set the registry of operators shared between the kernels of an equation
+  // system.
+  void SetOperatorRegistry(hephaestus::OperatorRegistry * operators) { _operators = operators; }
+
+  // Returns true if the contribution of this kernel has changed since the
+  // form it was applied to was last assembled.
+  virtual bool IsDirty() const
+  {
+    if (_dirty)
+    {
+      return true;
+    }
+    for (const auto & [coef_name, sequence] : _tracked_coefs)
+    {
+      if (_coefficients->GetSequence(coef_name) != sequence)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Force the form this kernel contributes to to be rebuilt.
+  void MarkDirty() { _dirty = true; }
+
+  // Called once the form this kernel contributes to has been assembled.
+  virtual void MarkClean()
+  {
+    _dirty = false;
+    for (auto & [coef_name, sequence] : _tracked_coefs)
+    {
+      sequence = _coefficients->GetSequence(coef_name);
+    }
+  }
+
+protected:
+  // Record a coefficient used by this kernel, so that changes to it mark the
+  // kernel as dirty.
+  void TrackCoefficient(hephaestus::Coefficients & coefficients, const std::string & coef_name)
+  {
+    _coefficients = &coefficients;
+    _tracked_coefs[coef_name] = coefficients.GetSequence(coef_name);
+  }
+
+  // Returns a state that changes whenever one of the tracked coefficients
+  // changes, for use with the OperatorRegistry. Coefficient sequence numbers
+  // only ever increase, so their sum increases whenever any one of them does.
+  long TrackedCoefficientsState() const
+  {
+    long state = 0;
+    for (const auto & [coef_name, sequence] : _tracked_coefs)
+    {
+      state += _coefficients->GetSequence(coef_name);
+    }
+    return state;
+  }
+
+  hephaestus::OperatorRegistry * _operators{nullptr};
+
+private:
+  bool _dirty{true};
+  hephaestus::Coefficients * _coefficients{nullptr};
+  std::map<std::string, long> _tracked_coefs;
 };
 
 } // namespace hephaestus
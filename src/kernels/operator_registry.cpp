@@ -0,0 +1,33 @@
+#include "operator_registry.hpp"
+
+namespace hephaestus
+{
+
+mfem::ParBilinearForm &
+OperatorRegistry::GetForm(const std::string & key,
+                          mfem::ParFiniteElementSpace & fespace,
+                          long state,
+                          const IntegratorAdder & add_integrators)
+{
+  auto it = _forms.find({key, &fespace});
+  if (it != _forms.end() && it->second._fespace_sequence == fespace.GetSequence() &&
+      it->second._state == state)
+  {
+    return *it->second._form;
+  }
+
+  auto form = std::make_unique<mfem::ParBilinearForm>(&fespace);
+  form->SetAssemblyLevel(_assembly_level);
+  add_integrators(*form);
+  form->Assemble();
+  form->Finalize();
+  _num_assemblies++;
+
+  auto & entry = _forms[{key, &fespace}];
+  entry._form = std::move(form);
+  entry._fespace_sequence = fespace.GetSequence();
+  entry._state = state;
+  return *entry._form;
+}
+
+} // namespace hephaestus
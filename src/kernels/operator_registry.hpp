@@ -0,0 +1,54 @@
+#pragma once
+#include "../common/pfem_extras.hpp"
+#include <functional>
+#include <map>
+
+namespace hephaestus
+{
+
+// Registry of assembled bilinear forms shared between the kernels of an
+// equation system, so that an operator needed by several kernels (e.g. a
+// curl-curl matrix used both in the system matrix and in a right hand side
+// term) is only assembled and stored once.
+class OperatorRegistry
+{
+public:
+  using IntegratorAdder = std::function<void(mfem::ParBilinearForm &)>;
+
+  OperatorRegistry() = default;
+
+  // Set the assembly level of forms assembled from now on.
+  void SetAssemblyLevel(mfem::AssemblyLevel assembly_level) { _assembly_level = assembly_level; }
+  [[nodiscard]] mfem::AssemblyLevel GetAssemblyLevel() const { return _assembly_level; }
+
+  // Returns the finalized form registered under key on fespace. The form is
+  // (re)assembled with the integrators added by add_integrators if it is
+  // missing, if its FE space has been updated, or if state differs from the
+  // state it was last assembled with (e.g. the sum of the sequence numbers of
+  // its coefficients, which only increase). The returned reference is only
+  // valid until the next request for the same key.
+  mfem::ParBilinearForm & GetForm(const std::string & key,
+                                  mfem::ParFiniteElementSpace & fespace,
+                                  long state,
+                                  const IntegratorAdder & add_integrators);
+
+  // Removes all forms.
+  void Clear() { _forms.clear(); }
+
+  // Number of times a form has been assembled by this registry.
+  [[nodiscard]] long GetNumAssemblies() const { return _num_assemblies; }
+
+private:
+  struct Entry
+  {
+    std::unique_ptr<mfem::ParBilinearForm> _form;
+    long _fespace_sequence;
+    long _state;
+  };
+
+  std::map<std::pair<std::string, const mfem::ParFiniteElementSpace *>, Entry> _forms;
+  mfem::AssemblyLevel _assembly_level{mfem::AssemblyLevel::LEGACY};
+  long _num_assemblies{0};
+};
+
+} // namespace hephaestus
@@ -18,16 +18,28 @@ WeakCurlCurlKernel::Init(hephaestus::GridFunctions & gridfunctions,
 {
   _u = gridfunctions.Get(_coupled_gf_name);
   _coef = coefficients._scalars.Get(_coef_name);
+  TrackCoefficient(coefficients, _coef_name);
 
-  _curl_curl = std::make_unique<mfem::ParBilinearForm>(_u->ParFESpace());
-  _curl_curl->AddDomainIntegrator(new mfem::CurlCurlIntegrator(*_coef));
-  _curl_curl->Assemble();
+  if (_operators == nullptr)
+  {
+    _curl_curl = std::make_unique<mfem::ParBilinearForm>(_u->ParFESpace());
+    _curl_curl->AddDomainIntegrator(new mfem::CurlCurlIntegrator(*_coef));
+    _curl_curl->Assemble();
+  }
 }
 
 void
 WeakCurlCurlKernel::Apply(mfem::ParLinearForm * lf)
 {
-  _curl_curl->AddMultTranspose(*_u, *lf, -1.0);
+  if (_operators == nullptr)
+  {
+    _curl_curl->AddMultTranspose(*_u, *lf, -1.0);
+    return;
+  }
+
+  auto & curl_curl = CurlCurlKernel::GetSharedForm(
+      *_operators, *_u->ParFESpace(), _coef_name, *_coef, TrackedCoefficientsState());
+  curl_curl.AddMultTranspose(*_u, *lf, -1.0);
 }
 
 } // namespace hephaestus
@@ -1,4 +1,5 @@
 #pragma once
+#include "curl_curl_kernel.hpp"
 #include "kernel_base.hpp"
 
 namespace hephaestus
@@ -6,6 +7,9 @@ namespace hephaestus
 
 /*
 (α∇×u_{n}, ∇×u')
+
+If the kernel belongs to an equation system, the curl-curl form is shared
+through its OperatorRegistry with a CurlCurlKernel using the same coefficient.
 */
 class WeakCurlCurlKernel : public Kernel<mfem::ParLinearForm>
 {
@@ -232,6 +232,13 @@ ProblemBuilder::ConstructJacobianSolverWithOptions(SolverType type, SolverParams
       solver_options.GetOptionalParam<int>("PrintLevel", default_params._print_level);
   const auto k_dim = solver_options.GetOptionalParam<unsigned int>("KDim", default_params._k_dim);
 
+  // Recycle a Krylov subspace between solves of the sequence of SPD systems
+  if ((type == SolverType::HYPRE_PCG || type == SolverType::PCG) &&
+      solver_options.GetOptionalParam<bool>("RecycleKrylovSubspace", false))
+  {
+    type = SolverType::RECYCLING_PCG;
+  }
+
   auto preconditioner =
       std::dynamic_pointer_cast<mfem::HypreSolver>(GetProblem()->_jacobian_preconditioner);
 
@@ -294,6 +301,57 @@ ProblemBuilder::ConstructJacobianSolverWithOptions(SolverType type, SolverParams
       GetProblem()->_jacobian_solver = solver;
       break;
     }
+    case SolverType::GMRES:
+    {
+      auto solver = std::make_shared<mfem::GMRESSolver>(GetProblem()->_comm);
+
+      solver->SetRelTol(tolerance);
+      solver->SetAbsTol(abs_tolerance);
+      solver->SetMaxIter(max_iter);
+      solver->SetKDim(k_dim);
+      solver->SetPrintLevel(print_level);
+
+      if (GetProblem()->_jacobian_preconditioner)
+        solver->SetPreconditioner(*GetProblem()->_jacobian_preconditioner);
+
+      GetProblem()->_jacobian_solver = solver;
+      break;
+    }
+    case SolverType::PCG:
+    {
+      auto solver = std::make_shared<mfem::CGSolver>(GetProblem()->_comm);
+
+      solver->SetRelTol(tolerance);
+      solver->SetAbsTol(abs_tolerance);
+      solver->SetMaxIter(max_iter);
+      solver->SetPrintLevel(print_level);
+
+      if (GetProblem()->_jacobian_preconditioner)
+        solver->SetPreconditioner(*GetProblem()->_jacobian_preconditioner);
+
+      GetProblem()->_jacobian_solver = solver;
+      break;
+    }
+    case SolverType::RECYCLING_PCG:
+    {
+      const auto recycle_dim = solver_options.GetOptionalParam<unsigned int>("RecycleDim", 5);
+      const auto num_stored_directions =
+          solver_options.GetOptionalParam<unsigned int>("RecycleStoredDirections", 20);
+
+      auto solver = std::make_shared<hephaestus::RecyclingPCGSolver>(
+          GetProblem()->_comm, recycle_dim, num_stored_directions);
+
+      solver->SetRelTol(tolerance);
+      solver->SetAbsTol(abs_tolerance);
+      solver->SetMaxIter(max_iter);
+      solver->SetPrintLevel(print_level);
+
+      if (GetProblem()->_jacobian_preconditioner)
+        solver->SetPreconditioner(*GetProblem()->_jacobian_preconditioner);
+
+      GetProblem()->_jacobian_solver = solver;
+      break;
+    }
     case SolverType::SUPER_LU:
     {
       auto solver = std::make_shared<hephaestus::SuperLUSolver>(GetProblem()->_comm);
@@ -114,7 +114,10 @@ protected:
     HYPRE_GMRES,
     HYPRE_FGMRES,
     HYPRE_AMG,
-    SUPER_LU
+    SUPER_LU,
+    GMRES,        // MFEM GMRES, for operators and preconditioners that are not Hypre objects
+    PCG,          // MFEM CG, for SPD operators and preconditioners that are not Hypre objects
+    RECYCLING_PCG // Deflated PCG recycling a Krylov subspace between solves (SPD systems)
   };
 
   /// Structure containing default parameters which can be passed to "ConstructJacobianSolverWithOptions".
@@ -1,6 +1,11 @@
 #pragma once
 #include "../common/pfem_extras.hpp"
 #include "inputs.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
 
 namespace hephaestus
 {
@@ -140,18 +145,795 @@ public:
   int _print_level;
 };
 
+/// Block preconditioner for coupled H(curl) × H1 systems, such as the A-V
+/// formulation. Applies AMS to the H(curl) block and BoomerAMG to the H1 block,
+/// either block-diagonally or block-lower-triangularly using the coupling
+/// block, without forming a monolithic matrix. SetOperator must be passed a
+/// 2×2 mfem::BlockOperator whose blocks are HypreParMatrix objects.
+class HCurlH1BlockPreconditioner : public mfem::Solver
+{
+public:
+  enum class Structure
+  {
+    DIAGONAL,
+    LOWER_TRIANGULAR
+  };
+
+  HCurlH1BlockPreconditioner(mfem::ParFiniteElementSpace * edge_fespace,
+                             Structure structure,
+                             int print_level = logger.level())
+    : _ams(edge_fespace), _structure(structure)
+  {
+    _ams.SetSingularProblem();
+    _ams.SetPrintLevel(print_level);
+    _amg.SetPrintLevel(print_level);
+  }
+
+  void SetOperator(const mfem::Operator & op) override
+  {
+    auto * block_op = dynamic_cast<mfem::BlockOperator *>(const_cast<mfem::Operator *>(&op));
+    if (block_op == nullptr || block_op->NumRowBlocks() != 2 || block_op->NumColBlocks() != 2)
+    {
+      MFEM_ABORT("HCurlH1BlockPreconditioner requires a 2x2 block operator.");
+    }
+    height = op.Height();
+    width = op.Width();
+    _offsets = block_op->RowOffsets();
+
+    _ams.SetOperator(block_op->GetBlock(0, 0));
+    _amg.SetOperator(block_op->GetBlock(1, 1));
+
+    if (_structure == Structure::DIAGONAL)
+    {
+      auto block_prec = std::make_unique<mfem::BlockDiagonalPreconditioner>(_offsets);
+      block_prec->SetDiagonalBlock(0, &_ams);
+      block_prec->SetDiagonalBlock(1, &_amg);
+      _block_prec = std::move(block_prec);
+    }
+    else
+    {
+      auto block_prec = std::make_unique<mfem::BlockLowerTriangularPreconditioner>(_offsets);
+      block_prec->SetDiagonalBlock(0, &_ams);
+      block_prec->SetDiagonalBlock(1, &_amg);
+      if (!block_op->IsZeroBlock(1, 0))
+      {
+        block_prec->SetBlock(1, 0, &block_op->GetBlock(1, 0));
+      }
+      _block_prec = std::move(block_prec);
+    }
+  }
+
+  void Mult(const mfem::Vector & x, mfem::Vector & y) const override { _block_prec->Mult(x, y); }
+
+private:
+  mfem::HypreAMS _ams;
+  mfem::HypreBoomerAMG _amg;
+  Structure _structure;
+  mfem::Array<int> _offsets;
+  std::unique_ptr<mfem::Solver> _block_prec{nullptr};
+};
+
+/// Block-diagonal preconditioner for the real 2×2 block form of a complex
+/// H(curl) system assembled by mfem::ParSesquilinearForm, e.g.
+/// (α∇×u, ∇×u') - (ω²ζu, u') + i(ωβu, u'). Both diagonal blocks apply AMS to
+/// the positive-definite auxiliary matrix (α∇×u, ∇×u') + (|ω²ζ|u, u') +
+/// (|ωβ|u, u'), passed with SetAuxiliaryMatrix, with the sign of the imaginary
+/// block set by the complex operator convention. The complex system itself is
+/// never flattened into a single real matrix.
+class ComplexHCurlBlockPreconditioner : public mfem::Solver
+{
+public:
+  ComplexHCurlBlockPreconditioner(mfem::ParFiniteElementSpace * edge_fespace,
+                                  mfem::ComplexOperator::Convention conv,
+                                  int print_level = logger.level())
+    : _ams(edge_fespace), _conv(conv)
+  {
+    _ams.SetPrintLevel(print_level);
+  }
+
+  /// Set the auxiliary real matrix the AMS blocks are built from. Must be
+  /// called whenever the complex system changes.
+  void SetAuxiliaryMatrix(std::unique_ptr<mfem::HypreParMatrix> aux)
+  {
+    _aux = std::move(aux);
+    height = width = 2 * _aux->Height();
+    _ams.SetOperator(*_aux);
+  }
+
+  /// The complex system operator is only used to check sizes; the blocks are
+  /// built from the auxiliary matrix.
+  void SetOperator(const mfem::Operator & op) override
+  {
+    MFEM_VERIFY(!_aux || (op.Height() == height && op.Width() == width),
+                "ComplexHCurlBlockPreconditioner: operator size does not match the "
+                "auxiliary matrix.");
+  }
+
+  void Mult(const mfem::Vector & x, mfem::Vector & y) const override
+  {
+    MFEM_VERIFY(_aux, "ComplexHCurlBlockPreconditioner: auxiliary matrix not set.");
+    const int n = height / 2;
+    mfem::Vector x_r, x_i, y_r, y_i;
+    x_r.MakeRef(const_cast<mfem::Vector &>(x), 0, n);
+    x_i.MakeRef(const_cast<mfem::Vector &>(x), n, n);
+    y_r.MakeRef(y, 0, n);
+    y_i.MakeRef(y, n, n);
+
+    _ams.Mult(x_r, y_r);
+    _ams.Mult(x_i, y_i);
+    if (_conv == mfem::ComplexOperator::BLOCK_SYMMETRIC)
+    {
+      y_i.Neg();
+    }
+  }
+
+private:
+  mfem::HypreAMS _ams;
+  mfem::ComplexOperator::Convention _conv;
+  std::unique_ptr<mfem::HypreParMatrix> _aux{nullptr};
+};
+
+/// Preconditioner for high-order systems, built from a spectrally equivalent
+/// low-order refined (LOR) discretisation of the same bilinear form. The
+/// high-order form is given as a weighted sum of unassembled forms, which is
+/// assembled on the LOR space, has its essential DoFs eliminated and is
+/// inverted approximately with AMS (H(curl)), ADS (H(div)) or BoomerAMG (H1).
+/// The LOR space shares the true DoF numbering of the high-order space, so the
+/// preconditioner applies to fully assembled and matrix-free systems alike.
+class LORPreconditioner : public mfem::Solver
+{
+public:
+  using FormTerms = std::vector<std::pair<std::shared_ptr<mfem::ParBilinearForm>, double>>;
+
+  LORPreconditioner(mfem::ParFiniteElementSpace * fespace,
+                    std::function<FormTerms()> get_form_terms,
+                    std::function<const mfem::Array<int> &()> get_ess_tdof_list,
+                    int print_level = -1,
+                    bool singular = false)
+    : _lor(*fespace),
+      _get_form_terms(std::move(get_form_terms)),
+      _get_ess_tdof_list(std::move(get_ess_tdof_list)),
+      _print_level(print_level),
+      _singular(singular)
+  {
+  }
+
+  /// Reassembles the LOR matrix from the current form terms. The operator is
+  /// only used to check sizes.
+  void SetOperator(const mfem::Operator & op) override
+  {
+    height = op.Height();
+    width = op.Width();
+
+    _solver.reset();
+    _lor_mat.reset();
+    const mfem::Array<int> no_ess_dofs;
+    for (const auto & [form, scale] : _get_form_terms())
+    {
+      _lor.AssembleSystem(*form, no_ess_dofs);
+      const mfem::HypreParMatrix & term = _lor.GetAssembledMatrix();
+      if (_lor_mat == nullptr)
+      {
+        _lor_mat = std::make_unique<mfem::HypreParMatrix>(term);
+        *_lor_mat *= scale;
+      }
+      else
+      {
+        _lor_mat.reset(mfem::Add(1.0, *_lor_mat, scale, term));
+      }
+    }
+    MFEM_VERIFY(_lor_mat != nullptr, "LORPreconditioner: no bilinear form terms to assemble.");
+    MFEM_VERIFY(_lor_mat->Height() == height,
+                "LORPreconditioner: LOR matrix size does not match the operator.");
+    _lor_mat->EliminateBC(_get_ess_tdof_list(), mfem::Operator::DIAG_ONE);
+
+    auto * fec = _lor.GetParFESpace().FEColl();
+    if (dynamic_cast<const mfem::ND_FECollection *>(fec) != nullptr)
+    {
+      auto ams = std::make_unique<mfem::HypreAMS>(*_lor_mat, &_lor.GetParFESpace());
+      if (_singular)
+      {
+        ams->SetSingularProblem();
+      }
+      ams->SetPrintLevel(_print_level);
+      _solver = std::move(ams);
+    }
+    else if (dynamic_cast<const mfem::RT_FECollection *>(fec) != nullptr)
+    {
+      auto ads = std::make_unique<mfem::HypreADS>(*_lor_mat, &_lor.GetParFESpace());
+      ads->SetPrintLevel(_print_level);
+      _solver = std::move(ads);
+    }
+    else if (dynamic_cast<const mfem::H1_FECollection *>(fec) != nullptr)
+    {
+      auto amg = std::make_unique<mfem::HypreBoomerAMG>(*_lor_mat);
+      amg->SetPrintLevel(_print_level);
+      _solver = std::move(amg);
+    }
+    else
+    {
+      MFEM_ABORT("LORPreconditioner: unsupported finite element collection " << fec->Name());
+    }
+  }
+
+  void Mult(const mfem::Vector & x, mfem::Vector & y) const override { _solver->Mult(x, y); }
+
+private:
+  mfem::ParLORDiscretization _lor;
+  std::function<FormTerms()> _get_form_terms;
+  std::function<const mfem::Array<int> &()> _get_ess_tdof_list;
+  int _print_level;
+  bool _singular;
+
+  // The matrix must outlive the solver built from it
+  std::unique_ptr<mfem::HypreParMatrix> _lor_mat{nullptr};
+  std::unique_ptr<mfem::Solver> _solver{nullptr};
+};
+
+/// Preconditioned conjugate gradient solver with Krylov subspace recycling
+/// (deflated CG). After each solve, approximate eigenvectors belonging to the
+/// smallest eigenvalues are extracted from the recycle space and the first
+/// search directions, and carried over to the next solve, where they are
+/// deflated from the search space. This targets slow modes left behind by the
+/// preconditioner in sequences of closely related SPD systems.
+///
+/// Convergence is declared when ||b - Ax|| <= max(rel_tol ||b||, abs_tol).
+class RecyclingPCGSolver : public mfem::IterativeSolver
+{
+public:
+  RecyclingPCGSolver(MPI_Comm comm, int recycle_dim = 5, int num_stored_directions = 20)
+    : mfem::IterativeSolver(comm),
+      _recycle_dim(recycle_dim),
+      _num_stored_directions(num_stored_directions)
+  {
+  }
+
+  void Mult(const mfem::Vector & b, mfem::Vector & x) const override
+  {
+    MFEM_VERIFY(oper != nullptr, "RecyclingPCGSolver: operator not set.");
+    const int n = b.Size();
+    _r.SetSize(n);
+    _z.SetSize(n);
+    _p.SetSize(n);
+    _ap.SetSize(n);
+    _directions.clear();
+    _a_directions.clear();
+
+    if (!iterative_mode)
+    {
+      x = 0.0;
+    }
+
+    // Refresh the image of the recycle space under the current operator
+    for (std::size_t i = 0; i < _w.size(); i++)
+    {
+      oper->Mult(_w[i], _aw[i]);
+    }
+    UpdateCoarseOperator();
+
+    oper->Mult(x, _r);
+    mfem::subtract(b, _r, _r);
+
+    // Galerkin correction of the initial guess over the recycle space
+    mfem::Vector mu;
+    if (!_w.empty())
+    {
+      CoarseSolve(_w, _r, mu);
+      for (std::size_t i = 0; i < _w.size(); i++)
+      {
+        x.Add(mu(i), _w[i]);
+        _r.Add(-mu(i), _aw[i]);
+      }
+    }
+
+    const double tolerance = std::max(rel_tol * std::sqrt(Dot(b, b)), abs_tol);
+    double r_norm = std::sqrt(Dot(_r, _r));
+
+    ApplyPreconditioner(_r, _z);
+    _p = _z;
+    Deflate(_z, _p);
+    double rz = Dot(_r, _z);
+
+    converged = false;
+    int it = 0;
+    for (; it < max_iter; it++)
+    {
+      if (print_options.iterations)
+      {
+        logger.info("RecyclingPCGSolver: iteration {:3d}, ||r|| = {:e}", it, r_norm);
+      }
+      if (r_norm <= tolerance)
+      {
+        converged = true;
+        break;
+      }
+
+      oper->Mult(_p, _ap);
+      const double pap = Dot(_p, _ap);
+      if (pap <= 0.0)
+      {
+        logger.warn("RecyclingPCGSolver: operator is not positive definite (p·Ap = {}).", pap);
+        break;
+      }
+
+      // Keep the first A-normalised search directions for the recycle space
+      if (_directions.size() < _num_stored_directions)
+      {
+        _directions.emplace_back(_p);
+        _directions.back() /= std::sqrt(pap);
+        _a_directions.emplace_back(_ap);
+        _a_directions.back() /= std::sqrt(pap);
+      }
+
+      const double alpha = rz / pap;
+      x.Add(alpha, _p);
+      _r.Add(-alpha, _ap);
+      r_norm = std::sqrt(Dot(_r, _r));
+
+      ApplyPreconditioner(_r, _z);
+      const double rz_new = Dot(_r, _z);
+      const double beta = rz_new / rz;
+      rz = rz_new;
+
+      // p = z + βp - W E⁻¹ (AW)ᵀ z
+      mfem::add(_z, beta, _p, _p);
+      Deflate(_z, _p);
+    }
+    final_iter = it;
+    final_norm = r_norm;
+    if (r_norm <= tolerance)
+    {
+      converged = true;
+    }
+    if (print_options.summary || print_options.first_and_last)
+    {
+      logger.info("RecyclingPCGSolver: {} iterations, ||r|| = {:e}", final_iter, final_norm);
+    }
+    if (!converged && print_options.warnings)
+    {
+      logger.warn("RecyclingPCGSolver: no convergence after {} iterations.", final_iter);
+    }
+
+    // Estimate savings against the first solve, which had no recycle space
+    if (_baseline_iterations < 0)
+    {
+      _baseline_iterations = final_iter;
+    }
+    else
+    {
+      const int saved = std::max(_baseline_iterations - final_iter, 0);
+      _iterations_saved += saved;
+      if (print_options.summary)
+      {
+        logger.info("RecyclingPCGSolver: {} iterations with a recycle space of dimension {}; "
+                    "{} saved ({} in total)",
+                    final_iter,
+                    _w.size(),
+                    saved,
+                    _iterations_saved);
+      }
+    }
+
+    UpdateRecycleSpace();
+  }
+
+  /// Total estimated number of iterations saved by recycling, compared to the
+  /// first solve.
+  [[nodiscard]] int GetIterationsSaved() const { return _iterations_saved; }
+
+private:
+  void ApplyPreconditioner(const mfem::Vector & r, mfem::Vector & z) const
+  {
+    if (prec)
+    {
+      prec->Mult(r, z);
+    }
+    else
+    {
+      z = r;
+    }
+  }
+
+  // E = Wᵀ A W
+  void UpdateCoarseOperator() const
+  {
+    const int k = _w.size();
+    _e.SetSize(k);
+    for (int i = 0; i < k; i++)
+    {
+      for (int j = 0; j < k; j++)
+      {
+        _e(i, j) = Dot(_w[i], _aw[j]);
+      }
+    }
+    if (k > 0)
+    {
+      _e_inv = std::make_unique<mfem::DenseMatrixInverse>(_e);
+    }
+  }
+
+  // mu = E⁻¹ Vᵀ r, for V = W or AW
+  void CoarseSolve(const std::vector<mfem::Vector> & v,
+                   const mfem::Vector & r,
+                   mfem::Vector & mu) const
+  {
+    mfem::Vector vtr(v.size());
+    for (std::size_t i = 0; i < v.size(); i++)
+    {
+      vtr(i) = Dot(v[i], r);
+    }
+    mu.SetSize(v.size());
+    _e_inv->Mult(vtr, mu);
+  }
+
+  // Make p A-orthogonal to the recycle space: p -= W E⁻¹ (AW)ᵀ z
+  void Deflate(const mfem::Vector & z, mfem::Vector & p) const
+  {
+    if (_w.empty())
+    {
+      return;
+    }
+    mfem::Vector mu;
+    CoarseSolve(_aw, z, mu);
+    for (std::size_t i = 0; i < _w.size(); i++)
+    {
+      p.Add(-mu(i), _w[i]);
+    }
+  }
+
+  // Rayleigh-Ritz over span{W, stored directions}: keep the approximate
+  // eigenvectors of A with the smallest eigenvalues.
+  void UpdateRecycleSpace() const
+  {
+    // A-orthonormal basis Q of the candidate space, by modified Gram-Schmidt
+    std::vector<mfem::Vector> q, aq;
+    auto add_candidate = [&](mfem::Vector v, mfem::Vector av)
+    {
+      const double initial_norm = std::sqrt(std::abs(Dot(v, av)));
+      for (std::size_t j = 0; j < q.size(); j++)
+      {
+        const double alpha = Dot(aq[j], v);
+        v.Add(-alpha, q[j]);
+        av.Add(-alpha, aq[j]);
+      }
+      const double norm = std::sqrt(std::abs(Dot(v, av)));
+      if (norm > 1.0e-10 * initial_norm && norm > 0.0)
+      {
+        v /= norm;
+        av /= norm;
+        q.push_back(std::move(v));
+        aq.push_back(std::move(av));
+      }
+    };
+    for (std::size_t i = 0; i < _w.size(); i++)
+    {
+      add_candidate(_w[i], _aw[i]);
+    }
+    for (std::size_t i = 0; i < _directions.size(); i++)
+    {
+      add_candidate(_directions[i], _a_directions[i]);
+    }
+
+    // With QᵀAQ = I, the Ritz problem QᵀAQ y = θ QᵀQ y becomes QᵀQ y = θ⁻¹ y,
+    // so the smallest Ritz values correspond to the largest eigenvalues of QᵀQ.
+    const int s = q.size();
+    mfem::DenseMatrix g(s);
+    for (int i = 0; i < s; i++)
+    {
+      for (int j = i; j < s; j++)
+      {
+        g(i, j) = g(j, i) = Dot(q[i], q[j]);
+      }
+    }
+    mfem::Vector eigenvalues;
+    mfem::DenseMatrix eigenvectors;
+    SymmetricEigensystem(g, eigenvalues, eigenvectors);
+
+    std::vector<int> order(s);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(),
+              order.end(),
+              [&](int a, int b) { return eigenvalues(a) > eigenvalues(b); });
+
+    const int k = std::min(_recycle_dim, s);
+    _w.assign(k, mfem::Vector(_r.Size()));
+    _aw.assign(k, mfem::Vector(_r.Size()));
+    for (int i = 0; i < k; i++)
+    {
+      _w[i] = 0.0;
+      _aw[i] = 0.0;
+      for (int j = 0; j < s; j++)
+      {
+        _w[i].Add(eigenvectors(j, order[i]), q[j]);
+        _aw[i].Add(eigenvectors(j, order[i]), aq[j]);
+      }
+    }
+    _directions.clear();
+    _a_directions.clear();
+  }
+
+  // Cyclic Jacobi eigenvalue algorithm for small dense symmetric matrices.
+  static void
+  SymmetricEigensystem(mfem::DenseMatrix a, mfem::Vector & eigenvalues, mfem::DenseMatrix & v)
+  {
+    const int n = a.Height();
+    v.SetSize(n);
+    v = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+      v(i, i) = 1.0;
+    }
+
+    for (int sweep = 0; sweep < 50; sweep++)
+    {
+      double off_diagonal = 0.0;
+      for (int i = 0; i < n; i++)
+      {
+        for (int j = i + 1; j < n; j++)
+        {
+          off_diagonal += a(i, j) * a(i, j);
+        }
+      }
+      if (off_diagonal <= 1.0e-30 * std::max(a.FNorm2(), 1.0e-300))
+      {
+        break;
+      }
+
+      for (int p = 0; p < n; p++)
+      {
+        for (int q = p + 1; q < n; q++)
+        {
+          if (a(p, q) == 0.0)
+          {
+            continue;
+          }
+          const double theta = (a(q, q) - a(p, p)) / (2.0 * a(p, q));
+          const double t = ((theta >= 0.0) ? 1.0 : -1.0) /
+                           (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+          const double c = 1.0 / std::sqrt(t * t + 1.0);
+          const double sn = t * c;
+          for (int k = 0; k < n; k++)
+          {
+            const double akp = a(k, p);
+            const double akq = a(k, q);
+            a(k, p) = c * akp - sn * akq;
+            a(k, q) = sn * akp + c * akq;
+          }
+          for (int k = 0; k < n; k++)
+          {
+            const double apk = a(p, k);
+            const double aqk = a(q, k);
+            a(p, k) = c * apk - sn * aqk;
+            a(q, k) = sn * apk + c * aqk;
+          }
+          for (int k = 0; k < n; k++)
+          {
+            const double vkp = v(k, p);
+            const double vkq = v(k, q);
+            v(k, p) = c * vkp - sn * vkq;
+            v(k, q) = sn * vkp + c * vkq;
+          }
+        }
+      }
+    }
+
+    eigenvalues.SetSize(n);
+    for (int i = 0; i < n; i++)
+    {
+      eigenvalues(i) = a(i, i);
+    }
+  }
+
+  int _recycle_dim;
+  std::size_t _num_stored_directions;
+
+  mutable std::vector<mfem::Vector> _w, _aw;
+  mutable std::vector<mfem::Vector> _directions, _a_directions;
+  mutable mfem::DenseMatrix _e;
+  mutable std::unique_ptr<mfem::DenseMatrixInverse> _e_inv{nullptr};
+  mutable mfem::Vector _r, _z, _p, _ap;
+
+  mutable int _baseline_iterations{-1};
+  mutable int _iterations_saved{0};
+};
+
+/// Returns the number of iterations taken in the last solve by an iterative
+/// solver, or -1 if the solver does not report it.
+inline int
+GetNumIterations(const mfem::Solver & solver)
+{
+  int num_iterations = -1;
+  if (const auto * iterative_solver = dynamic_cast<const mfem::IterativeSolver *>(&solver))
+  {
+    num_iterations = iterative_solver->GetNumIterations();
+  }
+  else if (const auto * pcg = dynamic_cast<const mfem::HyprePCG *>(&solver))
+  {
+    pcg->GetNumIterations(num_iterations);
+  }
+  else if (const auto * gmres = dynamic_cast<const mfem::HypreGMRES *>(&solver))
+  {
+    gmres->GetNumIterations(num_iterations);
+  }
+  else if (const auto * fgmres = dynamic_cast<const mfem::HypreFGMRES *>(&solver))
+  {
+    fgmres->GetNumIterations(num_iterations);
+  }
+  return num_iterations;
+}
+
+/// Wraps a Jacobian solver so that the setup of its preconditioner is only
+/// repeated when required by the reuse policy. Skipping SetOperator on the
+/// wrapped solver keeps the preconditioner built for an earlier matrix; the
+/// Krylov iterations still use the current values of the operator, provided it
+/// is updated in place (see EquationSystem persistent sparsity).
+class ReusableJacobianSolver : public mfem::Solver
+{
+public:
+  enum class ReusePolicy
+  {
+    ALWAYS_REBUILD,     // Set up the preconditioner on every call to SetOperator
+    REBUILD_ON_CHANGE,  // Set up when the operator structure or values change
+    ITERATION_THRESHOLD // Set up when iterations grow past a ratio of those after setup
+  };
+
+  ReusableJacobianSolver(std::shared_ptr<mfem::Solver> solver,
+                         ReusePolicy policy,
+                         double iteration_ratio = 1.5)
+    : _solver(std::move(solver)), _policy(policy), _iteration_ratio(iteration_ratio)
+  {
+  }
+
+  /// Signal that the values of the operator have changed since the last setup.
+  void MarkOperatorChanged()
+  {
+    if (_policy == ReusePolicy::REBUILD_ON_CHANGE)
+    {
+      _rebuild = true;
+    }
+  }
+
+  /// Signal that the operator has been reallocated; always forces a new setup.
+  void MarkStructureChanged() { _rebuild = true; }
+
+  void SetOperator(const mfem::Operator & op) override
+  {
+    // A different operator object always requires a new setup
+    if (_policy == ReusePolicy::ALWAYS_REBUILD || _rebuild || &op != _op ||
+        op.Height() != height || op.Width() != width)
+    {
+      height = op.Height();
+      width = op.Width();
+      _op = &op;
+      _solver->SetOperator(op);
+      _rebuild = false;
+      _iterations_after_setup = -1;
+      _num_setups++;
+    }
+  }
+
+  void Mult(const mfem::Vector & x, mfem::Vector & y) const override
+  {
+    _solver->iterative_mode = iterative_mode;
+    _solver->Mult(x, y);
+
+    const int num_iterations = GetNumIterations(*_solver);
+    if (_policy != ReusePolicy::ITERATION_THRESHOLD || num_iterations < 0)
+    {
+      return;
+    }
+    if (_iterations_after_setup < 0)
+    {
+      _iterations_after_setup = num_iterations;
+    }
+    else if (num_iterations > _iteration_ratio * std::max(_iterations_after_setup, 1))
+    {
+      _rebuild = true;
+    }
+  }
+
+  [[nodiscard]] mfem::Solver & GetSolver() const { return *_solver; }
+  [[nodiscard]] int GetNumSetups() const { return _num_setups; }
+
+private:
+  std::shared_ptr<mfem::Solver> _solver;
+  ReusePolicy _policy;
+  double _iteration_ratio;
+  const mfem::Operator * _op{nullptr};
+  mutable bool _rebuild{true};
+  mutable int _iterations_after_setup{-1};
+  int _num_setups{0};
+};
+
 class SuperLUSolver : public mfem::SuperLUSolver
 {
 public:
-  SuperLUSolver(MPI_Comm comm, int npdep = 1) : mfem::SuperLUSolver(comm, npdep){};
+  SuperLUSolver(MPI_Comm comm, int npdep = 1) : mfem::SuperLUSolver(comm, npdep), _comm(comm){};
+
+  /// Factorizes the operator. The existing factorization is kept if the
+  /// operator is unchanged since the last call, and the symbolic factorization
+  /// (column permutation and elimination tree) is reused if only its values
+  /// have changed. Changes are detected by hashing the matrix, so the operator
+  /// need not be the same object between calls.
   void SetOperator(const mfem::Operator & op) override
   {
+    const auto * hypre_op = dynamic_cast<const mfem::HypreParMatrix *>(&op);
+    const bool hashable = (hypre_op != nullptr);
+
+    std::uint64_t structure_hash = 0;
+    std::uint64_t values_hash = 0;
+    if (hashable)
+    {
+      HashMatrix(*hypre_op, structure_hash, values_hash);
+    }
+
+    // 0: unchanged, 1: values changed, 2: structure changed. All ranks must
+    // agree, so take the largest change seen by any rank.
+    int local_change = 2;
+    if (_a_superlu && hashable && _hashed && structure_hash == _structure_hash)
+    {
+      local_change = (values_hash == _values_hash) ? 0 : 1;
+    }
+    int change = 2;
+    MPI_Allreduce(&local_change, &change, 1, MPI_INT, MPI_MAX, _comm);
+
+    _hashed = hashable;
+    _structure_hash = structure_hash;
+    _values_hash = values_hash;
+
+    if (change == 0)
+    {
+      logger.debug("SuperLUSolver: operator unchanged, reusing factorization");
+      return;
+    }
+
+    SetFact(change == 1 ? mfem::superlu::SamePattern : mfem::superlu::DOFACT);
     _a_superlu = std::make_unique<mfem::SuperLURowLocMatrix>(op);
     mfem::SuperLUSolver::SetOperator(*_a_superlu.get());
   }
 
 private:
+  // FNV-1a hashes of the sparsity pattern and of the values of a matrix.
+  static void HashMatrix(const mfem::HypreParMatrix & a,
+                         std::uint64_t & structure_hash,
+                         std::uint64_t & values_hash)
+  {
+    mfem::SparseMatrix diag, offd;
+    HYPRE_BigInt * col_map_offd = nullptr;
+    a.GetDiag(diag);
+    a.GetOffd(offd, col_map_offd);
+
+    const HYPRE_BigInt sizes[] = {a.GetGlobalNumRows(), a.GetGlobalNumCols(), a.GetRowStarts()[0]};
+
+    structure_hash = 14695981039346656037ULL;
+    Hash(structure_hash, sizes, sizeof(sizes));
+    Hash(structure_hash, diag.HostReadI(), (diag.Height() + 1) * sizeof(int));
+    Hash(structure_hash, diag.HostReadJ(), diag.NumNonZeroElems() * sizeof(int));
+    Hash(structure_hash, offd.HostReadI(), (offd.Height() + 1) * sizeof(int));
+    Hash(structure_hash, offd.HostReadJ(), offd.NumNonZeroElems() * sizeof(int));
+    Hash(structure_hash, col_map_offd, offd.Width() * sizeof(HYPRE_BigInt));
+
+    values_hash = 14695981039346656037ULL;
+    Hash(values_hash, diag.HostReadData(), diag.NumNonZeroElems() * sizeof(double));
+    Hash(values_hash, offd.HostReadData(), offd.NumNonZeroElems() * sizeof(double));
+  }
+
+  static void Hash(std::uint64_t & hash, const void * data, std::size_t num_bytes)
+  {
+    const auto * bytes = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < num_bytes; i++)
+    {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+  }
+
+  MPI_Comm _comm;
   std::unique_ptr<mfem::SuperLURowLocMatrix> _a_superlu{nullptr};
+
+  bool _hashed{false};
+  std::uint64_t _structure_hash{0};
+  std::uint64_t _values_hash{0};
 };
 
 } // namespace hephaestus
@@ -1,28 +1,40 @@
 #include "closed_coil.hpp"
 
+#include <algorithm>
+#include <unordered_set>
 #include <utility>
 
 namespace hephaestus
 {
 
-// Pushes an element into a vector if the vector does not yet contain that same
-// element
-template <typename T>
-void
-pushIfUnique(std::vector<T> & vec, const T el)
+namespace
 {
 
-  bool verify = true;
+// Restricts a coefficient to the elements flagged in a marker array indexed by
+// element number, and evaluates to zero elsewhere.
+class ElementRestrictedCoefficient : public mfem::Coefficient
+{
+public:
+  ElementRestrictedCoefficient(mfem::Coefficient & coef, const mfem::Array<int> & el_markers)
+    : _coef(coef), _el_markers(el_markers)
+  {
+  }
 
-  for (auto e : vec)
+  double Eval(mfem::ElementTransformation & T, const mfem::IntegrationPoint & ip) override
   {
-    if (e == el)
-      verify = false;
+    const int el = T.ElementNo;
+    if (el < 0 || el >= _el_markers.Size() || !_el_markers[el])
+      return 0.0;
+
+    return _coef.Eval(T, ip);
   }
 
-  if (verify == true)
-    vec.push_back(el);
-}
+private:
+  mfem::Coefficient & _coef;
+  const mfem::Array<int> & _el_markers;
+};
+
+} // namespace
 
 // Base class methods
 
@@ -152,11 +164,15 @@ ClosedCoilSolver::Init(hephaestus::GridFunctions & gridfunctions,
     *_final_lf = 0.0;
   }
 
+  hephaestus::AttrToMarker(_coil_domains, _coil_markers, _mesh_parent->attributes.Max());
+
+  // The submeshes and their spaces are rebuilt below
+  _transfer_maps.Clear();
   MakeWedge();
   PrepareCoilSubmesh();
   SolveTransition();
   SolveCoil();
-  RestoreAttributes();
+  SolveCurrentDensity();
 }
 
 void
@@ -179,17 +195,8 @@ ClosedCoilSolver::Apply(mfem::ParLinearForm * lf)
 
   if (_source_current_density)
   {
-    hephaestus::GridFunctions aux_gf;
-    aux_gf.Register("source_electric_field", _source_electric_field);
-    aux_gf.Register("source_current_density", _source_current_density);
-
-    hephaestus::Coefficients aux_coef;
-    aux_coef._scalars.Register("electrical_conductivity", _sigma);
-
-    hephaestus::ScaledVectorGridFunctionAux current_density_auxsolver(
-        "source_electric_field", "source_current_density", "electrical_conductivity", 1.0);
-    current_density_auxsolver.Init(aux_gf, aux_coef);
-    current_density_auxsolver.Solve();
+    *_source_current_density = 0.0;
+    _source_current_density->Add(i, *_j_t_parent);
   }
 }
 
@@ -203,155 +210,167 @@ ClosedCoilSolver::SubtractSource(mfem::ParGridFunction * gf)
 void
 ClosedCoilSolver::MakeWedge()
 {
-  std::vector<int> bdr_els;
-
-  // First we save the current domain attributes so they may be restored later
-  for (int e = 0; e < _mesh_parent->GetNE(); ++e)
-    _old_dom_attrs.push_back(_mesh_parent->GetAttribute(e));
+  // The wedge is built on the coil submesh, so that the parent mesh is never
+  // modified and the work done here scales with the size of the coil
+  _mesh_coil = std::make_unique<mfem::ParSubMesh>(
+      mfem::ParSubMesh::CreateFromDomain(*_mesh_parent, _coil_domains));
 
+  // The new attributes must not clash with those of the parent mesh either, as
+  // the coefficients are shared between the two
   _new_domain_attr = _mesh_parent->attributes.Max() + 1;
 
-  _elec_attrs.second = _mesh_parent->bdr_attributes.Max() + 1;
+  int max_bdr_attr = _mesh_parent->bdr_attributes.Max();
+  if (_mesh_coil->bdr_attributes.Size() > 0)
+    max_bdr_attr = std::max(max_bdr_attr, _mesh_coil->bdr_attributes.Max());
+  _elec_attrs.second = max_bdr_attr + 1;
 
-  // Now we need to find the electrode boundary
-  for (int i = 0; i < _mesh_parent->GetNBE(); ++i)
+  // Now we need to find the electrode faces on the coil submesh
+  std::vector<int> elec_face_list;
+  for (int i = 0; i < _mesh_coil->GetNBE(); ++i)
   {
-    if (_mesh_parent->GetBdrAttribute(i) == _elec_attrs.first)
+    if (_mesh_coil->GetBdrAttribute(i) == _elec_attrs.first)
     {
-      bdr_els.push_back(i);
+      elec_face_list.push_back(_mesh_coil->GetBdrElementFaceIndex(i));
+    }
+  }
+
+  // The electrode is an internal boundary of the coil, which the submesh does
+  // not necessarily inherit from the parent. If so, it is copied over.
+  int has_elec = elec_face_list.empty() ? 0 : 1;
+  int any_has_elec;
+  MPI_Allreduce(&has_elec, &any_has_elec, 1, MPI_INT, MPI_MAX, _mesh_parent->GetComm());
+  if (any_has_elec == 0)
+  {
+    const mfem::Array<int> & parent_to_coil_faces = _mesh_coil->GetParentToSubMeshFaceIDMap();
+    for (int i = 0; i < _mesh_parent->GetNBE(); ++i)
+    {
+      if (_mesh_parent->GetBdrAttribute(i) != _elec_attrs.first)
+        continue;
+
+      const int face = parent_to_coil_faces[_mesh_parent->GetBdrElementFaceIndex(i)];
+      if (face == -1)
+        continue;
+
+      auto * new_elem = _mesh_coil->GetFace(face)->Duplicate(_mesh_coil.get());
+      new_elem->SetAttribute(_elec_attrs.first);
+      _mesh_coil->AddBdrElement(new_elem);
+      elec_face_list.push_back(face);
     }
   }
 
   Plane3D plane;
 
-  if (bdr_els.size() > 0)
+  if (elec_face_list.size() > 0)
   {
-    plane.Make3DPlane(_mesh_parent, _mesh_parent->GetBdrElementFaceIndex(bdr_els[0]));
+    plane.Make3DPlane(_mesh_coil.get(), elec_face_list[0]);
   }
 
-  std::vector<int> elec_vtx;
-  // Create a vector containing all of the vertices on the electrode
-  for (auto b_fc : bdr_els)
+  // Hashed sets of the electrode faces and of all vertices on the electrode
+  std::unordered_set<int> elec_faces(elec_face_list.begin(), elec_face_list.end());
+  std::unordered_set<int> elec_vtx;
+  for (auto face : elec_face_list)
   {
-
     mfem::Array<int> face_vtx;
-    _mesh_parent->GetFaceVertices(_mesh_parent->GetBdrElementFaceIndex(b_fc), face_vtx);
-
-    for (auto v : face_vtx)
-      pushIfUnique(elec_vtx, v);
+    _mesh_coil->GetFaceVertices(face, face_vtx);
+    elec_vtx.insert(face_vtx.begin(), face_vtx.end());
   }
 
-  // Now we need to find all elements in the mesh that touch, on at least one
-  // vertex, the electrode face. If they do touch the vertex, are on one side of
-  // the electrode, and belong to the coil domain, we add them to our wedge
-
-  std::vector<int> wedge_els;
+  // Now we need to find all elements in the coil that touch, on at least one
+  // vertex, the electrode face. If they do touch the vertex and are on one side
+  // of the electrode, we add them to our wedge. Only elements around electrode
+  // vertices are visited, through the vertex-to-element table.
+  std::unique_ptr<mfem::Table> vtx_to_els(_mesh_coil->GetVertexToElementTable());
 
-  for (int e = 0; e < _mesh_parent->GetNE(); ++e)
+  std::unordered_set<int> wedge_el_set;
+  for (auto v : elec_vtx)
   {
-
-    if (!IsInDomain(e, _coil_domains, _mesh_parent) ||
-        plane.Side(ElementCentre(e, _mesh_parent)) == 1)
-      continue;
-
-    mfem::Array<int> elem_vtx;
-    _mesh_parent->GetElementVertices(e, elem_vtx);
-
-    for (auto v1 : elem_vtx)
+    const int * els = vtx_to_els->GetRow(v);
+    for (int j = 0; j < vtx_to_els->RowSize(v); ++j)
     {
-      for (auto v2 : elec_vtx)
-      {
-        if (v1 == v2)
-        {
-          pushIfUnique(wedge_els, e);
-        }
-      }
+      const int e = els[j];
+      if (wedge_el_set.count(e) || plane.Side(ElementCentre(e, _mesh_coil.get())) == 1)
+        continue;
+
+      wedge_el_set.insert(e);
     }
   }
 
+  // Sorted for a deterministic ordering
+  std::vector<int> wedge_els(wedge_el_set.begin(), wedge_el_set.end());
+  std::sort(wedge_els.begin(), wedge_els.end());
+
   AddWedgeToPWCoefs(wedge_els);
 
+  // The parent mesh sees the wedge only through this element marker array
+  const mfem::Array<int> & parent_el_ids = _mesh_coil->GetParentElementIDMap();
+  _wedge_parent_markers.SetSize(_mesh_parent->GetNE());
+  _wedge_parent_markers = 0;
+  for (auto e : wedge_els)
+    _wedge_parent_markers[parent_el_ids[e]] = 1;
+
   // Now we set the second electrode boundary attribute. Start with a list of
   // all the faces of the wedge elements and eliminate mesh and coil boundaries,
   // the first electrode, and faces between wedge elements
 
-  std::vector<int> wedge_faces;
+  std::unordered_set<int> wedge_face_set;
   mfem::Array<int> el_faces;
   mfem::Array<int> ori;
 
   for (auto e : wedge_els)
   {
-    _mesh_parent->GetElementFaces(e, el_faces, ori);
-    for (auto f : el_faces)
-      pushIfUnique(wedge_faces, f);
+    _mesh_coil->GetElementFaces(e, el_faces, ori);
+    wedge_face_set.insert(el_faces.begin(), el_faces.end());
   }
 
+  std::vector<int> wedge_faces(wedge_face_set.begin(), wedge_face_set.end());
+  std::sort(wedge_faces.begin(), wedge_faces.end());
+
   for (auto wf : wedge_faces)
   {
 
     int e1, e2;
-    _mesh_parent->GetFaceElements(wf, &e1, &e2);
+    _mesh_coil->GetFaceElements(wf, &e1, &e2);
 
     // If the face is a coil boundary
-    if (!(IsInDomain(e1, _coil_domains, _mesh_parent) &&
-          IsInDomain(e2, _coil_domains, _mesh_parent)))
+    if (!(IsInDomain(e1, _coil_domains, _mesh_coil.get()) &&
+          IsInDomain(e2, _coil_domains, _mesh_coil.get())))
     {
       continue;
     }
 
     // If the face is not true interior
-    if (!(_mesh_parent->FaceIsInterior(wf) ||
-          (_mesh_parent->GetFaceInformation(wf).tag == mfem::Mesh::FaceInfoTag::SharedConforming ||
-           _mesh_parent->GetFaceInformation(wf).tag ==
+    if (!(_mesh_coil->FaceIsInterior(wf) ||
+          (_mesh_coil->GetFaceInformation(wf).tag == mfem::Mesh::FaceInfoTag::SharedConforming ||
+           _mesh_coil->GetFaceInformation(wf).tag ==
                mfem::Mesh::FaceInfoTag::SharedSlaveNonconforming)))
     {
       continue;
     }
 
     // If the face is shared between two elements internal to the wedge
-    bool test1 = false;
-    bool test2 = false;
-    for (auto e : wedge_els)
-    {
-      if (e == e1)
-        test1 = true;
-      if (e == e2)
-        test2 = true;
-    }
-
-    if (test1 && test2)
+    if (wedge_el_set.count(e1) && wedge_el_set.count(e2))
       continue;
 
     // If the face is part of the first electrode
-    test1 = false;
-    for (auto b_fc : bdr_els)
-    {
-      if (wf == _mesh_parent->GetBdrElementFaceIndex(b_fc))
-      {
-        test1 = true;
-        break;
-      }
-    }
-    if (test1)
+    if (elec_faces.count(wf))
       continue;
 
     // At last, if the face is none of these things, it must be our second
     // electrode
-    auto * new_elem = _mesh_parent->GetFace(wf)->Duplicate(_mesh_parent);
+    auto * new_elem = _mesh_coil->GetFace(wf)->Duplicate(_mesh_coil.get());
     new_elem->SetAttribute(_elec_attrs.second);
-    _mesh_parent->AddBdrElement(new_elem);
+    _mesh_coil->AddBdrElement(new_elem);
   }
 
   // Only after this do we set the domain attributes
   for (auto e : wedge_els)
-    _mesh_parent->SetAttribute(e, _new_domain_attr);
+    _mesh_coil->SetAttribute(e, _new_domain_attr);
 
   _transition_domain.Append(_new_domain_attr);
-  _coil_domains.Append(_new_domain_attr);
 
-  _mesh_parent->FinalizeTopology();
-  _mesh_parent->Finalize();
-  _mesh_parent->SetAttributes();
+  _mesh_coil->FinalizeTopology();
+  _mesh_coil->Finalize();
+  _mesh_coil->SetAttributes();
 }
 
 void
@@ -363,30 +382,16 @@ ClosedCoilSolver::AddWedgeToPWCoefs(std::vector<int> & wedge_els)
   hephaestus::Subdomain new_domain("wedge", _new_domain_attr);
   int wedge_old_att = -1;
 
-  // This creates a binary representation of which MPI ranks contain at
-  // least one wedge element. The lowest rank which contains the wedge will be used as a reference
-  // for the old attribute
-  int ref_rank = 0;
-  int has_els = (bool)wedge_els.size() ? 1 << mfem::Mpi::WorldRank() : 0;
-  int has_els_sum;
-
-  MPI_Allreduce(&has_els, &has_els_sum, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-  if (has_els_sum == 0)
+  // The lowest rank which contains the wedge will be used as a reference for
+  // the old attribute
+  const int ref_rank = hephaestus::LowestRankWith(!wedge_els.empty(), _mesh_coil->GetComm());
+  if (ref_rank < 0)
     mfem::mfem_error("ClosedCoilSolver wedge has size zero!");
 
-  for (int i = 0; i < mfem::Mpi::WorldSize(); ++i)
-  {
-    if ((1 << i & has_els_sum) != 0)
-    {
-      ref_rank = i;
-      break;
-    }
-  }
-
-  if (mfem::Mpi::WorldRank() == ref_rank)
-    wedge_old_att = _mesh_parent->GetAttribute(wedge_els[0]);
+  if (_mesh_coil->GetMyRank() == ref_rank)
+    wedge_old_att = _mesh_coil->GetAttribute(wedge_els[0]);
 
-  MPI_Bcast(&wedge_old_att, 1, MPI_INT, ref_rank, MPI_COMM_WORLD);
+  MPI_Bcast(&wedge_old_att, 1, MPI_INT, ref_rank, _mesh_coil->GetComm());
 
   // Now we check in which of the old subdomains the wedge lies
   int sd_wedge = -1;
@@ -470,9 +475,6 @@ ClosedCoilSolver::AddWedgeToPWCoefs(std::vector<int> & wedge_els)
 void
 ClosedCoilSolver::PrepareCoilSubmesh()
 {
-  _mesh_coil = std::make_unique<mfem::ParSubMesh>(
-      mfem::ParSubMesh::CreateFromDomain(*_mesh_parent, _coil_domains));
-
   _electric_field_aux_coil_fec =
       std::make_unique<mfem::ND_FECollection>(_order_hcurl, _mesh_coil->Dimension());
 
@@ -489,18 +491,21 @@ ClosedCoilSolver::PrepareCoilSubmesh()
   _h1_fe_space_coil =
       std::make_unique<mfem::ParFiniteElementSpace>(_mesh_coil.get(), _h1_fe_space_coil_fec.get());
 
-  _v_coil = std::make_unique<mfem::ParGridFunction>(_h1_fe_space_coil.get());
+  _v_coil = std::make_shared<mfem::ParGridFunction>(_h1_fe_space_coil.get());
   *_v_coil = 0.0;
 
   _mesh_t = std::make_unique<mfem::ParSubMesh>(
-      mfem::ParSubMesh::CreateFromDomain(*_mesh_parent, _transition_domain));
+      mfem::ParSubMesh::CreateFromDomain(*_mesh_coil, _transition_domain));
 }
 
 void
 ClosedCoilSolver::SolveTransition()
 {
-  auto v_parent = std::make_shared<mfem::ParGridFunction>(_h1_fe_space_parent.get());
-  *v_parent = 0.0;
+  // The OpenCoilSolver is set up on the coil submesh, which holds the wedge
+  // attributes and the second electrode
+  auto electric_field_t_coil =
+      std::make_shared<mfem::ParGridFunction>(_electric_field_aux_coil_fes.get());
+  *electric_field_t_coil = 0.0;
 
   hephaestus::FESpaces fespaces;
   hephaestus::BCMap bc_maps;
@@ -509,11 +514,11 @@ ClosedCoilSolver::SolveTransition()
   coefs._scalars.Register("electrical_conductivity", _sigma);
 
   hephaestus::GridFunctions gridfunctions;
-  gridfunctions.Register("ElectricField_parent", _source_electric_field);
-  gridfunctions.Register("V_parent", v_parent);
+  gridfunctions.Register("ElectricField_coil", electric_field_t_coil);
+  gridfunctions.Register("V_coil", _v_coil);
 
-  hephaestus::OpenCoilSolver opencoil("ElectricField_parent",
-                                      "V_parent",
+  hephaestus::OpenCoilSolver opencoil("ElectricField_coil",
+                                      "V_coil",
                                       "I",
                                       "electrical_conductivity",
                                       _transition_domain,
@@ -523,9 +528,20 @@ ClosedCoilSolver::SolveTransition()
                                       _solver_options);
 
   opencoil.Init(gridfunctions, fespaces, bc_maps, coefs);
-  opencoil.Apply(_final_lf.get());
 
-  _mesh_coil->Transfer(*v_parent, *_v_coil);
+  mfem::ParLinearForm lf_coil(_electric_field_aux_coil_fes.get());
+  lf_coil = 0.0;
+  opencoil.Apply(&lf_coil);
+
+  *_source_electric_field = 0.0;
+  _transfer_maps.Transfer(*electric_field_t_coil, *_source_electric_field);
+
+  // (σEt, ψ) over the wedge, integrated on the parent mesh
+  ElementRestrictedCoefficient sigma_wedge(*_sigma, _wedge_parent_markers);
+  mfem::ParBilinearForm m_t(_h_curl_fe_space_parent);
+  m_t.AddDomainIntegrator(new mfem::VectorFEMassIntegrator(sigma_wedge), _coil_markers);
+  m_t.Assemble();
+  m_t.AddMult(*_source_electric_field, *_final_lf, 1.0);
 }
 
 void
@@ -557,25 +573,13 @@ ClosedCoilSolver::SolveCoil()
 
   mfem::Array<int> ess_bdr_tdofs_coil;
 
-  // This creates a binary representation of which MPI ranks contain at
-  // least one element
-  int ref_rank = 0;
-  int has_els = (bool)_mesh_coil->GetNE() ? 1 << mfem::Mpi::WorldRank() : 0;
-  int has_els_sum;
-
-  MPI_Allreduce(&has_els, &has_els_sum, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-  MFEM_ASSERT(has_els_sum != 0, "Empty coil submesh!");
-
-  for (int i = 0; i < mfem::Mpi::WorldSize(); ++i)
-  {
-    if ((1 << i & has_els_sum) != 0)
-    {
-      ref_rank = i;
-      break;
-    }
-  }
+  // The potential is fixed at the first true dof of the lowest rank that owns
+  // any
+  const int ref_rank =
+      hephaestus::LowestRankWith(_h1_fe_space_coil->GetTrueVSize() > 0, _mesh_coil->GetComm());
+  MFEM_VERIFY(ref_rank >= 0, "Empty coil submesh!");
 
-  if (mfem::Mpi::WorldRank() == ref_rank)
+  if (_mesh_coil->GetMyRank() == ref_rank)
   {
     ess_bdr_tdofs_coil.SetSize(1);
     ess_bdr_tdofs_coil[0] = 0;
@@ -601,29 +605,27 @@ ClosedCoilSolver::SolveCoil()
     _electric_field_t_parent = std::make_unique<mfem::ParGridFunction>(*_source_electric_field);
 
   *_source_electric_field = 0.0;
-  _mesh_coil->Transfer(*_electric_field_aux_coil, *_source_electric_field);
+  _transfer_maps.Transfer(*_electric_field_aux_coil, *_source_electric_field);
 
   mfem::ParBilinearForm m1(_h_curl_fe_space_parent);
-  hephaestus::AttrToMarker(_coil_domains, _coil_markers, _mesh_parent->attributes.Max());
-
   m1.AddDomainIntegrator(new mfem::VectorFEMassIntegrator(_sigma.get()), _coil_markers);
   m1.Assemble();
   m1.AddMult(*_source_electric_field, *_final_lf, 1.0);
 
-  // We can't properly calculate the flux of Jaux on the parent mesh, so we
+  // We can't properly calculate the flux of Jaux on the coil mesh, so we
   // transfer it first to the transition mesh. This will be used in the
   // normalisation step
-  auto electric_field_aux_t_fec =
+  _electric_field_aux_t_fec =
       std::make_unique<mfem::ND_FECollection>(_order_hcurl, _mesh_t->Dimension());
 
-  auto electric_field_aux_t_pfes =
-      std::make_unique<mfem::ParFiniteElementSpace>(_mesh_t.get(), electric_field_aux_t_fec.get());
+  _electric_field_aux_t_fes = std::make_unique<mfem::ParFiniteElementSpace>(
+      _mesh_t.get(), _electric_field_aux_t_fec.get());
 
   auto electric_field_aux_t =
-      std::make_unique<mfem::ParGridFunction>(electric_field_aux_t_pfes.get());
+      std::make_unique<mfem::ParGridFunction>(_electric_field_aux_t_fes.get());
   *electric_field_aux_t = 0.0;
 
-  _mesh_t->Transfer(*_source_electric_field, *electric_field_aux_t);
+  _transfer_maps.Transfer(*_electric_field_aux_coil, *electric_field_aux_t);
 
   // The total flux across the electrode face is Φ_t + Φ_aux
   // where Φ_t is the transition flux, already normalised to be -1
@@ -640,17 +642,34 @@ ClosedCoilSolver::SolveCoil()
 }
 
 void
-ClosedCoilSolver::RestoreAttributes()
+ClosedCoilSolver::SolveCurrentDensity()
 {
-  // Domain attributes
-  for (int e = 0; e < _mesh_parent->GetNE(); ++e)
+  if (!_source_current_density)
+    return;
+
+  // J = σE for unit current. The electric field is only non-zero when
+  // transferred to the parent mesh.
+  _j_t_parent = std::make_unique<mfem::ParGridFunction>(_source_current_density->ParFESpace());
+  *_j_t_parent = 0.0;
+
+  if (_electric_field_transfer)
   {
-    _mesh_parent->SetAttribute(e, _old_dom_attrs[e]);
-  }
+    *_source_electric_field = *_electric_field_t_parent;
 
-  _mesh_parent->FinalizeTopology();
-  _mesh_parent->Finalize();
-  _mesh_parent->SetAttributes();
+    hephaestus::GridFunctions aux_gf;
+    aux_gf.Register("source_electric_field", _source_electric_field);
+    aux_gf.Register("source_current_density", _source_current_density);
+
+    hephaestus::Coefficients aux_coef;
+    aux_coef._scalars.Register("electrical_conductivity", _sigma);
+
+    hephaestus::ScaledVectorGridFunctionAux current_density_auxsolver(
+        "source_electric_field", "source_current_density", "electrical_conductivity", 1.0);
+    current_density_auxsolver.Init(aux_gf, aux_coef);
+    current_density_auxsolver.Solve();
+
+    *_j_t_parent = *_source_current_density;
+  }
 }
 
 // Auxiliary methods
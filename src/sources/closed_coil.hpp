@@ -39,18 +39,20 @@ public:
   void Apply(mfem::ParLinearForm * lf) override;
   void SubtractSource(mfem::ParGridFunction * gf) override;
 
-  // Finds the electrode face and applies a single domain attribute to a
-  // 1-element layer adjacent to it. Applies a different domain attribute to
-  // other elements in the coil. Also applies different boundary attributes on
-  // the two opposing faces of the layer, to act as Dirichlet BCs.
+  // Extracts the coil submesh, finds the electrode face and applies a single
+  // domain attribute to a 1-element layer adjacent to it. Also applies
+  // different boundary attributes on the two opposing faces of the layer, to
+  // act as Dirichlet BCs. Only the coil submesh is modified; on the parent
+  // mesh the wedge is described by an element marker array.
   void MakeWedge();
 
   // Detects whether the coefficients passed to CCS have piecewise-defined functions and if so, adds
   // the new wedge subdomain to them
   void AddWedgeToPWCoefs(std::vector<int> & wedge_els);
 
-  // Extracts the coil submesh and prepares the gridfunctions and FE spaces
-  // for being passed to the OpenCoilSolver in the transition region
+  // Extracts the transition submesh from the coil submesh and prepares the
+  // gridfunctions and FE spaces for being passed to the OpenCoilSolver in the
+  // transition region
   void PrepareCoilSubmesh();
 
   // Applies the OpenCoilSolver to the transition region
@@ -59,8 +61,9 @@ public:
   // Solves for the current in the coil region
   void SolveCoil();
 
-  // Resets the domain attributes on the parent mesh to what they were initially
-  void RestoreAttributes();
+  // Computes the current density for unit current, which Apply scales by the
+  // coil current
+  void SolveCurrentDensity();
 
   // Finds the coordinates for the "centre of mass" of the vertices of an
   // element.
@@ -81,9 +84,9 @@ private:
   mfem::Array<int> _coil_markers;
   mfem::Array<int> _transition_domain;
   mfem::Array<int> _transition_markers;
+  mfem::Array<int> _wedge_parent_markers;
   std::shared_ptr<mfem::Coefficient> _sigma{nullptr};
   std::shared_ptr<mfem::Coefficient> _itotal{nullptr};
-  std::vector<int> _old_dom_attrs;
   hephaestus::InputParameters _solver_options;
   hephaestus::Coefficients _ccs_coefs;
 
@@ -117,16 +120,26 @@ private:
   // In case J transfer is true
   std::unique_ptr<mfem::ParGridFunction> _electric_field_t_parent{nullptr};
 
+  // Current density for unit current, if a current density GridFunction is set
+  std::unique_ptr<mfem::ParGridFunction> _j_t_parent{nullptr};
+
   // Coil mesh, FE Space, and current
   std::unique_ptr<mfem::ParSubMesh> _mesh_coil{nullptr};
   std::unique_ptr<mfem::ParSubMesh> _mesh_t{nullptr};
   std::unique_ptr<mfem::ParFiniteElementSpace> _h1_fe_space_coil{nullptr};
   std::unique_ptr<mfem::ParGridFunction> _electric_field_aux_coil{nullptr};
-  std::unique_ptr<mfem::ParGridFunction> _v_coil{nullptr};
+  std::shared_ptr<mfem::ParGridFunction> _v_coil{nullptr};
 
   std::unique_ptr<mfem::ND_FECollection> _electric_field_aux_coil_fec{nullptr};
   std::unique_ptr<mfem::ParFiniteElementSpace> _electric_field_aux_coil_fes{nullptr};
 
+  // Transition mesh FE space, used for the flux normalisation
+  std::unique_ptr<mfem::ND_FECollection> _electric_field_aux_t_fec{nullptr};
+  std::unique_ptr<mfem::ParFiniteElementSpace> _electric_field_aux_t_fes{nullptr};
+
+  // Transfer maps between the parent, coil and transition meshes
+  hephaestus::TransferMapCache _transfer_maps;
+
   // Final LinearForm
   std::unique_ptr<mfem::ParLinearForm> _final_lf{nullptr};
 };
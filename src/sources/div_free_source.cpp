@@ -1,5 +1,4 @@
 #include "div_free_source.hpp"
-#include "helmholtz_projector.hpp"
 
 namespace hephaestus
 {
@@ -55,8 +54,43 @@ DivFreeSource::Init(hephaestus::GridFunctions & gridfunctions,
   _bc_map = &bc_map;
   _gridfunctions = &gridfunctions;
   _fespaces = &fespaces;
+  _coefficients = &coefficients;
+
+  if (_perform_helmholtz_projection)
+  {
+    hephaestus::InputParameters projector_pars;
+    projector_pars.SetParam("VectorGridFunctionName", _src_gf_name);
+    projector_pars.SetParam("ScalarGridFunctionName", _potential_gf_name);
+    projector_pars.SetParam("H1FESpaceName", _h1_fespace_name);
+    projector_pars.SetParam("HCurlFESpaceName", _hcurl_fespace_name);
+
+    _projector = std::make_unique<hephaestus::HelmholtzProjector>(projector_pars);
+  }
 
   BuildHCurlMass();
+
+  if (_support_attributes.Size() > 0)
+  {
+    BuildSupportMass();
+  }
+  _projection_solver.reset();
+
+  if (_separable_time_function)
+  {
+    BuildSeparableProfile();
+  }
+}
+
+void
+DivFreeSource::SetSeparableTimeFunction(std::function<double(double)> time_function)
+{
+  _separable_time_function = std::move(time_function);
+}
+
+void
+DivFreeSource::SetSupport(mfem::Array<int> support_attributes)
+{
+  _support_attributes = std::move(support_attributes);
 }
 
 void
@@ -66,56 +100,151 @@ DivFreeSource::BuildHCurlMass()
   _h_curl_mass->AddDomainIntegrator(new mfem::VectorFEMassIntegrator);
   _h_curl_mass->Assemble();
   _h_curl_mass->Finalize();
+  _h_curl_mass_sequence = _h_curl_fe_space->GetSequence();
 }
 
 void
-DivFreeSource::Apply(mfem::ParLinearForm * lf)
+DivFreeSource::BuildSupportMass()
+{
+  mfem::ParMesh * mesh = _h_curl_fe_space->GetParMesh();
+  hephaestus::AttrToMarker(_support_attributes, _support_markers, mesh->attributes.Max());
+
+  _support_mass = std::make_unique<mfem::ParBilinearForm>(_h_curl_fe_space);
+  _support_mass->AddDomainIntegrator(new mfem::VectorFEMassIntegrator, _support_markers);
+  _support_mass->Assemble();
+  _support_mass->Finalize();
+
+  // Find the true dofs not touched by any element of the support, on any rank
+  mfem::Array<int> support_ldofs(_h_curl_fe_space->GetVSize());
+  support_ldofs = 0;
+  mfem::Array<int> vdofs;
+  for (int e = 0; e < mesh->GetNE(); ++e)
+  {
+    if (!_support_markers[mesh->GetAttribute(e) - 1])
+      continue;
+
+    _h_curl_fe_space->GetElementVDofs(e, vdofs);
+    for (auto vdof : vdofs)
+      support_ldofs[(vdof >= 0) ? vdof : -1 - vdof] = 1;
+  }
+  _h_curl_fe_space->Synchronize(support_ldofs);
+
+  mfem::Array<int> outside_ldofs(support_ldofs.Size());
+  for (int i = 0; i < support_ldofs.Size(); ++i)
+    outside_ldofs[i] = support_ldofs[i] ? 0 : 1;
+
+  mfem::Array<int> outside_tdofs(_h_curl_fe_space->GetTrueVSize());
+  _h_curl_fe_space->GetRestrictionMatrix()->BooleanMult(outside_ldofs, outside_tdofs);
+  mfem::FiniteElementSpace::MarkerToList(outside_tdofs, _support_ess_tdofs);
+}
+
+void
+DivFreeSource::BuildProjectionSolver()
+{
+  mfem::ParBilinearForm & mass = _support_mass ? *_support_mass : *_h_curl_mass;
+
+  _projection_solver.reset();
+  _projection_mat = std::make_unique<mfem::HypreParMatrix>();
+  mass.FormSystemMatrix(_support_ess_tdofs, *_projection_mat);
+  _projection_solver = std::make_unique<DefaultGMRESSolver>(_solver_options, *_projection_mat);
+}
+
+void
+DivFreeSource::BuildSeparableProfile()
 {
-  // Find an averaged representation of current density in H(curl)*
-  _g->ProjectCoefficient(*_source_vec_coef);
+  ProjectSource();
+  _separable_profile = *_div_free_src_gf;
+  _separable_lf.SetSize(_div_free_src_gf->Size());
+  _h_curl_mass->Mult(*_div_free_src_gf, _separable_lf);
+  _separable_sequence = _h_curl_fe_space->GetSequence();
+}
+
+void
+DivFreeSource::ProjectSource()
+{
+  // Rebuild the mass matrices and the projection solver if the FE space has
+  // changed
+  if (_h_curl_fe_space->GetSequence() != _h_curl_mass_sequence)
+  {
+    BuildHCurlMass();
+    if (_support_mass)
+    {
+      BuildSupportMass();
+    }
+    _projection_solver.reset();
+  }
+  if (!_projection_solver)
+  {
+    BuildProjectionSolver();
+  }
+
+  // Find an averaged representation of current density in H(curl)*. If the
+  // source has a restricted support, it is only integrated over the support,
+  // and its projection is fixed to zero outside of it.
   mfem::ParLinearForm j(_h_curl_fe_space);
-  j.AddDomainIntegrator(new mfem::VectorFEDomainLFIntegrator(*_source_vec_coef));
+  if (_support_mass)
+  {
+    *_g = 0.0;
+    j.AddDomainIntegrator(new mfem::VectorFEDomainLFIntegrator(*_source_vec_coef),
+                          _support_markers);
+  }
+  else
+  {
+    _g->ProjectCoefficient(*_source_vec_coef);
+    j.AddDomainIntegrator(new mfem::VectorFEDomainLFIntegrator(*_source_vec_coef));
+  }
   j.Assemble();
   {
-    mfem::HypreParMatrix m;
+    // The projection is zero on the constrained true dofs outside the support
     mfem::Vector x, rhs;
-    mfem::Array<int> ess_tdof_list;
-    _h_curl_mass->FormLinearSystem(ess_tdof_list, *_g, j, m, x, rhs);
+    j.ParallelAssemble(rhs);
+    _g->GetTrueDofs(x);
+    x.SetSubVector(_support_ess_tdofs, 0.0);
+    rhs.SetSubVector(_support_ess_tdofs, 0.0);
 
-    DefaultGMRESSolver solver(_solver_options, m);
-    solver.Mult(rhs, x);
-
-    _h_curl_mass->RecoverFEMSolution(x, j, *_g);
+    _projection_solver->Mult(rhs, x);
+    _g->SetFromTrueDofs(x);
   }
 
   *_div_free_src_gf = *_g;
 
   if (_perform_helmholtz_projection)
   {
+    _projector->Project(*_gridfunctions, *_fespaces, _projector_bcs);
+  }
+}
 
-    hephaestus::InputParameters projector_pars;
-    projector_pars.SetParam("VectorGridFunctionName", _src_gf_name);
-    projector_pars.SetParam("ScalarGridFunctionName", _potential_gf_name);
-    projector_pars.SetParam("H1FESpaceName", _h1_fespace_name);
-    projector_pars.SetParam("HCurlFESpaceName", _hcurl_fespace_name);
-
-    hephaestus::BCMap bcs;
-
-    hephaestus::HelmholtzProjector projector(projector_pars);
-    projector.Project(*_gridfunctions, *_fespaces, bcs);
+void
+DivFreeSource::Apply(mfem::ParLinearForm * lf)
+{
+  if (_separable_time_function)
+  {
+    // The profile is only valid on the FE space it was projected onto
+    if (_h_curl_fe_space->GetSequence() != _separable_sequence)
+    {
+      BuildSeparableProfile();
+    }
+    _separable_scale = _separable_time_function(_coefficients->GetTime());
+    _div_free_src_gf->Set(_separable_scale, _separable_profile);
+    lf->Add(_separable_scale, _separable_lf);
+    return;
   }
 
-  // Add divergence free source to target linear form
-  _h_curl_mass->Update();
-  _h_curl_mass->Assemble();
-  _h_curl_mass->Finalize();
+  // Also reassembles the mass matrix if the FE space has changed
+  ProjectSource();
 
+  // Add divergence free source to target linear form
   _h_curl_mass->AddMult(*_div_free_src_gf, *lf, 1.0);
 }
 
 void
 DivFreeSource::SubtractSource(mfem::ParGridFunction * gf)
 {
+  if (_separable_time_function)
+  {
+    gf->Add(-_separable_scale, _separable_lf);
+    return;
+  }
   _h_curl_mass->AddMult(*_div_free_src_gf, *gf, -1.0);
 }
 
@@ -1,5 +1,7 @@
 #pragma once
+#include "helmholtz_projector.hpp"
 #include "source_base.hpp"
+#include <functional>
 
 namespace hephaestus
 {
@@ -26,6 +28,21 @@ public:
   void SubtractSource(mfem::ParGridFunction * gf) override;
   void BuildHCurlMass();
 
+  // Opt-in separable mode for sources of fixed spatial shape, J(x, t) = f(t)
+  // J₀(x). The source coefficient is taken as the time-independent profile
+  // J₀, which is projected and divergence cleaned during Init, and again only
+  // if the H(curl) FE space changes; Apply then adds the precomputed profile
+  // scaled by f(t). Must be called before Init.
+  void SetSeparableTimeFunction(std::function<double(double)> time_function);
+
+  // Restricts the source to the elements with the given domain attributes,
+  // outside of which it must be zero. The source is then only integrated and
+  // projected onto H(curl) over these elements. The Helmholtz projection is
+  // not restricted: it is still solved over the whole mesh, so the
+  // divergence-free source may extend beyond the support. If not set, the
+  // source is integrated over the whole mesh. Must be called before Init.
+  void SetSupport(mfem::Array<int> support_attributes);
+
   std::string _src_gf_name;
   std::string _src_coef_name;
   std::string _potential_gf_name;
@@ -54,6 +71,51 @@ public:
   std::shared_ptr<mfem::ParGridFunction> _div_free_src_gf;
 
   mfem::Solver * _solver{nullptr};
+
+protected:
+  // Projects the source coefficient into _div_free_src_gf, with optional
+  // Helmholtz projection.
+  void ProjectSource();
+
+  // Builds the H(curl) mass matrix over the support of the source, and the
+  // true dofs outside of it, which are fixed to zero in the projection.
+  void BuildSupportMass();
+
+  // Forms the constrained mass matrix of the H(curl) projection and sets up
+  // its solver, reused by every projection until the FE space changes.
+  void BuildProjectionSolver();
+
+  // Projects the time-independent profile of a separable source, and stores
+  // it with its dual for the current FE space.
+  void BuildSeparableProfile();
+
+  // Long-lived projector, reusing its H1 system and AMG setup between calls
+  std::unique_ptr<hephaestus::HelmholtzProjector> _projector{nullptr};
+  hephaestus::BCMap _projector_bcs;
+
+  // Support of the source, if restricted
+  mfem::Array<int> _support_attributes;
+  mfem::Array<int> _support_markers;
+  std::unique_ptr<mfem::ParBilinearForm> _support_mass{nullptr};
+  mfem::Array<int> _support_ess_tdofs;
+
+  // FE space sequence number at which _h_curl_mass was assembled
+  long _h_curl_mass_sequence{-1};
+
+  // Constrained mass matrix of the H(curl) projection and its solver. The
+  // matrix must outlive the solver built from it.
+  std::unique_ptr<mfem::HypreParMatrix> _projection_mat{nullptr};
+  std::unique_ptr<hephaestus::DefaultGMRESSolver> _projection_solver{nullptr};
+
+  std::function<double(double)> _separable_time_function{nullptr};
+  hephaestus::Coefficients * _coefficients{nullptr};
+
+  // Separable mode: divergence-free profile, its dual (M J₀) and current scale
+  mfem::Vector _separable_profile;
+  mfem::Vector _separable_lf;
+  double _separable_scale{0.0};
+  // FE space sequence number at which the separable profile was projected
+  long _separable_sequence{-1};
 };
 
 } // namespace hephaestus
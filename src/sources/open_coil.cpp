@@ -114,7 +114,6 @@ OpenCoilSolver::Init(hephaestus::GridFunctions & gridfunctions,
   else
   {
     _order_h1 = _phi_parent->ParFESpace()->FEColl()->GetOrder();
-    _phi_t_parent = std::make_unique<mfem::ParGridFunction>(*_phi_parent);
   }
 
   _mesh_parent = _source_electric_field->ParFESpace()->GetParMesh();
@@ -131,33 +130,40 @@ OpenCoilSolver::Apply(mfem::ParLinearForm * lf)
 {
 
   // The transformation and integration points themselves are not relevant, it's
-  // just so we can call Eval
-  mfem::ElementTransformation * tr = _mesh_parent->GetElementTransformation(0);
-  const mfem::IntegrationPoint & ip =
-      mfem::IntRules.Get(_source_electric_field->ParFESpace()->GetFE(0)->GetGeomType(), 1)
-          .IntPoint(0);
+  // just so we can call Eval. The parent mesh may be a submesh with no elements
+  // on this rank.
+  mfem::IsoparametricTransformation default_tr;
+  mfem::ElementTransformation * tr = &default_tr;
+  mfem::IntegrationPoint ip;
+  ip.Init(0);
+  if (_mesh_parent->GetNE() > 0)
+  {
+    tr = _mesh_parent->GetElementTransformation(0);
+    ip = mfem::IntRules.Get(_source_electric_field->ParFESpace()->GetFE(0)->GetGeomType(), 1)
+             .IntPoint(0);
+  }
 
   double i = _itotal->Eval(*tr, ip);
 
   if (_electric_field_transfer)
   {
     *_source_electric_field = 0.0;
-    _source_electric_field->Add(-i, *_grad_phi_t_parent);
+    _grad_phi_t_parent.AddTo(-i, *_source_electric_field);
   }
 
   if (_phi_parent != nullptr)
   {
     *_phi_parent = 0.0;
-    _phi_parent->Add(i, *_phi_t_parent);
+    _phi_t_parent.AddTo(i, *_phi_parent);
   }
 
   if (_source_current_density)
   {
     *_source_current_density = 0.0;
-    _source_current_density->Add(i, *_j_t_parent);
+    _j_t_parent.AddTo(i, *_source_current_density);
   }
 
-  lf->Add(i, *_final_lf);
+  _final_lf.AddTo(i, *lf);
 }
 
 void
@@ -206,23 +212,16 @@ OpenCoilSolver::MakeGridFunctions()
   if (_grad_phi_child == nullptr)
     _grad_phi_child = std::make_shared<mfem::ParGridFunction>(_h_curl_fe_space_child.get());
 
-  if (_grad_phi_t_parent == nullptr)
-    _grad_phi_t_parent = std::make_unique<mfem::ParGridFunction>(*_source_electric_field);
-
   if (_source_current_density)
   {
     if (_j_child == nullptr)
       _j_child = std::make_unique<mfem::ParGridFunction>(_h_div_fe_space_child.get());
 
-    if (_j_t_parent == nullptr)
-      _j_t_parent = std::make_unique<mfem::ParGridFunction>(*_source_current_density);
     *_j_child = 0.0;
-    *_j_t_parent = 0.0;
   }
 
   *_phi_child = 0.0;
   *_grad_phi_child = 0.0;
-  *_grad_phi_t_parent = 0.0;
 }
 
 void
@@ -268,9 +267,19 @@ OpenCoilSolver::SPSCurrent()
   if (_phi_child)
     *_phi_child /= abs(flux);
 
-  _mesh_child->Transfer(*_grad_phi_child, *_grad_phi_t_parent);
+  // The parent fields are only kept on the coil
+  mfem::ParGridFunction grad_phi_parent(_source_electric_field->ParFESpace());
+  grad_phi_parent = 0.0;
+  _transfer_maps.Transfer(*_grad_phi_child, grad_phi_parent);
+  _grad_phi_t_parent.Compress(grad_phi_parent);
+
   if (_phi_parent)
-    _mesh_child->Transfer(*_phi_child, *_phi_t_parent);
+  {
+    mfem::ParGridFunction phi_parent(_phi_parent->ParFESpace());
+    phi_parent = 0.0;
+    _transfer_maps.Transfer(*_phi_child, phi_parent);
+    _phi_t_parent.Compress(phi_parent);
+  }
 
   if (_source_current_density)
   {
@@ -286,14 +295,18 @@ OpenCoilSolver::SPSCurrent()
     current_density_auxsolver.Init(aux_gf, aux_coef);
     current_density_auxsolver.Solve();
 
-    _mesh_child->Transfer(*_j_child, *_j_t_parent);
+    mfem::ParGridFunction j_parent(_source_current_density->ParFESpace());
+    j_parent = 0.0;
+    _transfer_maps.Transfer(*_j_child, j_parent);
+    _j_t_parent.Compress(j_parent);
   }
 
   BuildM1();
 
-  _final_lf = std::make_unique<mfem::ParLinearForm>(_grad_phi_t_parent->ParFESpace());
-  *_final_lf = 0.0;
-  _m1->AddMult(*_grad_phi_t_parent, *_final_lf, -1.0);
+  mfem::ParLinearForm final_lf(_source_electric_field->ParFESpace());
+  final_lf = 0.0;
+  _m1->AddMult(grad_phi_parent, final_lf, -1.0);
+  _final_lf.Compress(final_lf);
 }
 
 void
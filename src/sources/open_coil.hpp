@@ -105,13 +105,13 @@ private:
   mfem::ParMesh * _mesh_parent{nullptr};
 
   mfem::ParGridFunction * _grad_phi_parent{nullptr};
-  std::unique_ptr<mfem::ParGridFunction> _grad_phi_t_parent{nullptr};
-
   std::shared_ptr<mfem::ParGridFunction> _phi_parent{nullptr};
-  std::unique_ptr<mfem::ParGridFunction> _phi_t_parent{nullptr};
-
   std::shared_ptr<mfem::ParGridFunction> _j_parent{nullptr};
-  std::unique_ptr<mfem::ParGridFunction> _j_t_parent{nullptr};
+
+  // Unit current fields on the parent mesh, which are only stored on the coil
+  hephaestus::CompressedVector _grad_phi_t_parent;
+  hephaestus::CompressedVector _phi_t_parent;
+  hephaestus::CompressedVector _j_t_parent;
 
   std::shared_ptr<mfem::ParGridFunction> _source_electric_field{nullptr};
   std::shared_ptr<mfem::ParGridFunction> _source_current_density{nullptr};
@@ -143,11 +143,14 @@ private:
   // Mass Matrix
   std::unique_ptr<mfem::ParBilinearForm> _m1{nullptr};
 
+  // Transfer maps from the child mesh to the parent mesh
+  hephaestus::TransferMapCache _transfer_maps;
+
   // BC Map
   hephaestus::BCMap _bc_maps;
 
-  // Final LinearForm
-  std::unique_ptr<mfem::ParLinearForm> _final_lf{nullptr};
+  // Final LinearForm for unit current, only stored on the coil
+  hephaestus::CompressedVector _final_lf;
 };
 
 } // namespace hephaestus
\ No newline at end of file
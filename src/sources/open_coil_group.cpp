@@ -0,0 +1,338 @@
+#include "open_coil_group.hpp"
+
+#include <utility>
+
+namespace hephaestus
+{
+
+namespace
+{
+
+// out = scale * s_k * unit on the dofs of coil k
+void
+ScaleByCoil(const mfem::Vector & unit,
+            const mfem::Array<int> & dof_coil,
+            const std::vector<double> & coil_scales,
+            double scale,
+            mfem::Vector & out)
+{
+  for (int i = 0; i < unit.Size(); ++i)
+  {
+    out(i) = (dof_coil[i] < 0) ? 0.0 : scale * coil_scales[dof_coil[i]] * unit(i);
+  }
+}
+
+} // namespace
+
+OpenCoilGroupSolver::OpenCoilGroupSolver(std::string source_efield_gf_name,
+                                         std::string phi_gf_name,
+                                         std::string cond_coef_name,
+                                         std::vector<Coil> coils,
+                                         std::string source_jfield_gf_name,
+                                         hephaestus::InputParameters solver_options)
+  : _coils(std::move(coils)),
+    _solver_options(std::move(solver_options)),
+    _source_efield_gf_name(std::move(source_efield_gf_name)),
+    _phi_gf_name(std::move(phi_gf_name)),
+    _cond_coef_name(std::move(cond_coef_name)),
+    _source_jfield_gf_name(std::move(source_jfield_gf_name))
+{
+}
+
+void
+OpenCoilGroupSolver::Init(hephaestus::GridFunctions & gridfunctions,
+                          const hephaestus::FESpaces & fespaces,
+                          hephaestus::BCMap & bc_map,
+                          hephaestus::Coefficients & coefficients)
+{
+  if (_coils.empty())
+  {
+    MFEM_ABORT("OpenCoilGroupSolver requires at least one coil.");
+  }
+
+  _itotals.clear();
+  for (const auto & coil : _coils)
+  {
+    if (!coefficients._scalars.Has(coil._i_coef_name))
+    {
+      logger.info("{} not found in coefficients when creating {}. Assuming unit current.",
+                  coil._i_coef_name,
+                  typeid(this).name());
+      _itotals.push_back(std::make_shared<mfem::ConstantCoefficient>(1.0));
+    }
+    else
+    {
+      _itotals.push_back(coefficients._scalars.GetShared(coil._i_coef_name));
+    }
+  }
+
+  if (!coefficients._scalars.Has(_cond_coef_name))
+  {
+    logger.info("{} not found in coefficients when creating {}. Assuming unit conductivity.",
+                _cond_coef_name,
+                typeid(this).name());
+    _sigma = std::make_shared<mfem::ConstantCoefficient>(1.0);
+  }
+  else
+  {
+    _sigma = coefficients._scalars.GetShared(_cond_coef_name);
+  }
+
+  _source_electric_field = gridfunctions.GetShared(_source_efield_gf_name);
+  if (_source_electric_field->ParFESpace()->FEColl()->GetContType() !=
+      mfem::FiniteElementCollection::TANGENTIAL)
+  {
+    mfem::mfem_error("Electric field GridFunction must be of HCurl type.");
+  }
+  _order_hcurl = _source_electric_field->ParFESpace()->FEColl()->GetOrder();
+  _order_h1 = _order_hcurl;
+
+  if (!_phi_gf_name.empty())
+  {
+    _phi_parent = gridfunctions.GetShared(_phi_gf_name);
+    if (_phi_parent->ParFESpace()->FEColl()->GetContType() !=
+        mfem::FiniteElementCollection::CONTINUOUS)
+    {
+      mfem::mfem_error("V GridFunction must be of H1 type.");
+    }
+    _order_h1 = _phi_parent->ParFESpace()->FEColl()->GetOrder();
+  }
+
+  if (!_source_jfield_gf_name.empty())
+  {
+    _source_current_density = gridfunctions.GetShared(_source_jfield_gf_name);
+    if (_source_current_density->ParFESpace()->FEColl()->GetContType() !=
+        mfem::FiniteElementCollection::NORMAL)
+    {
+      mfem::mfem_error("Current density GridFunction must be of HDiv type.");
+    }
+    _order_hdiv = _source_current_density->ParFESpace()->FEColl()->GetOrder();
+  }
+
+  _mesh_parent = _source_electric_field->ParFESpace()->GetParMesh();
+
+  _transfer_maps.Clear();
+  InitChildMesh();
+  MakeFESpaces();
+  SolvePotentials();
+  BuildM1();
+}
+
+void
+OpenCoilGroupSolver::Apply(mfem::ParLinearForm * lf)
+{
+  // The transformation and integration points themselves are not relevant, it's
+  // just so we can call Eval. The parent mesh may be a submesh with no elements
+  // on this rank.
+  mfem::IsoparametricTransformation default_tr;
+  mfem::ElementTransformation * tr = &default_tr;
+  mfem::IntegrationPoint ip;
+  ip.Init(0);
+  if (_mesh_parent->GetNE() > 0)
+  {
+    tr = _mesh_parent->GetElementTransformation(0);
+    ip = mfem::IntRules.Get(_source_electric_field->ParFESpace()->GetFE(0)->GetGeomType(), 1)
+             .IntPoint(0);
+  }
+
+  std::vector<double> currents;
+  for (const auto & itotal : _itotals)
+    currents.push_back(itotal->Eval(*tr, ip));
+
+  // E = -I ∇φ in each coil, with ∇φ normalised to unit current
+  mfem::ParGridFunction e_child(_h_curl_fe_space_child.get());
+  ScaleByCoil(*_grad_phi_child, _h_curl_dof_coil, currents, -1.0, e_child);
+
+  *_source_electric_field = 0.0;
+  _transfer_maps.Transfer(e_child, *_source_electric_field);
+
+  // The coils do not touch, so (σE, ψ) over the group is the sum over coils
+  _m1->AddMult(*_source_electric_field, *lf, 1.0);
+
+  if (_phi_parent)
+  {
+    mfem::ParGridFunction phi_child(_h1_fe_space_child.get());
+    ScaleByCoil(*_phi_child, _h1_dof_coil, currents, 1.0, phi_child);
+
+    *_phi_parent = 0.0;
+    _transfer_maps.Transfer(phi_child, *_phi_parent);
+  }
+
+  if (_source_current_density)
+  {
+    mfem::ParGridFunction j_child(_h_div_fe_space_child.get());
+    ScaleByCoil(*_j_child, _h_div_dof_coil, currents, 1.0, j_child);
+
+    *_source_current_density = 0.0;
+    _transfer_maps.Transfer(j_child, *_source_current_density);
+  }
+}
+
+void
+OpenCoilGroupSolver::InitChildMesh()
+{
+  _group_domains.DeleteAll();
+  _attr_to_coil.clear();
+
+  for (int k = 0; k < static_cast<int>(_coils.size()); ++k)
+  {
+    for (auto attr : _coils[k]._coil_domains)
+    {
+      if (!_attr_to_coil.emplace(attr, k).second)
+      {
+        MFEM_ABORT("Domain attribute " << attr
+                                       << " belongs to more than one coil in OpenCoilGroupSolver.");
+      }
+      _group_domains.Append(attr);
+    }
+  }
+
+  _mesh_child = std::make_unique<mfem::ParSubMesh>(
+      mfem::ParSubMesh::CreateFromDomain(*_mesh_parent, _group_domains));
+}
+
+void
+OpenCoilGroupSolver::MakeFESpaces()
+{
+  _h1_fe_space_fec_child =
+      std::make_unique<mfem::H1_FECollection>(_order_h1, _mesh_child->Dimension());
+  _h1_fe_space_child = std::make_unique<mfem::ParFiniteElementSpace>(
+      _mesh_child.get(), _h1_fe_space_fec_child.get());
+  MakeDofCoilMap(*_h1_fe_space_child, _h1_dof_coil);
+
+  _h_curl_fe_space_fec_child =
+      std::make_unique<mfem::ND_FECollection>(_order_hcurl, _mesh_child->Dimension());
+  _h_curl_fe_space_child = std::make_unique<mfem::ParFiniteElementSpace>(
+      _mesh_child.get(), _h_curl_fe_space_fec_child.get());
+  MakeDofCoilMap(*_h_curl_fe_space_child, _h_curl_dof_coil);
+
+  if (_source_current_density)
+  {
+    _h_div_fe_space_fec_child =
+        std::make_unique<mfem::RT_FECollection>(_order_hdiv - 1, _mesh_child->Dimension());
+    _h_div_fe_space_child = std::make_unique<mfem::ParFiniteElementSpace>(
+        _mesh_child.get(), _h_div_fe_space_fec_child.get());
+    MakeDofCoilMap(*_h_div_fe_space_child, _h_div_dof_coil);
+  }
+}
+
+void
+OpenCoilGroupSolver::MakeDofCoilMap(const mfem::ParFiniteElementSpace & fes,
+                                    mfem::Array<int> & dof_coil) const
+{
+  dof_coil.SetSize(fes.GetVSize());
+  dof_coil = -1;
+
+  mfem::Array<int> vdofs;
+  for (int e = 0; e < _mesh_child->GetNE(); ++e)
+  {
+    const int coil = _attr_to_coil.at(_mesh_child->GetAttribute(e));
+    fes.GetElementVDofs(e, vdofs);
+    for (auto vdof : vdofs)
+    {
+      const int dof = (vdof >= 0) ? vdof : -1 - vdof;
+      if (dof_coil[dof] != -1 && dof_coil[dof] != coil)
+      {
+        MFEM_ABORT("Coils " << dof_coil[dof] << " and " << coil
+                            << " in OpenCoilGroupSolver touch each other.");
+      }
+      dof_coil[dof] = coil;
+    }
+  }
+}
+
+void
+OpenCoilGroupSolver::SolvePotentials()
+{
+  // The terminal potentials of all coils are imposed together. As the coils do
+  // not touch, the conductivity-weighted Laplacian is block diagonal over the
+  // coils, and one solve with a single preconditioner gives the potential of
+  // every coil.
+  mfem::Array<int> high_terminals, low_terminals, terminals;
+  for (const auto & coil : _coils)
+  {
+    high_terminals.Append(coil._electrodes.first);
+    low_terminals.Append(coil._electrodes.second);
+  }
+  terminals.Append(high_terminals);
+  terminals.Append(low_terminals);
+
+  const int max_bdr_attr = _mesh_child->bdr_attributes.Max();
+  mfem::Array<int> high_markers, low_markers, ess_bdr_markers;
+  hephaestus::AttrToMarker(high_terminals, high_markers, max_bdr_attr);
+  hephaestus::AttrToMarker(low_terminals, low_markers, max_bdr_attr);
+  hephaestus::AttrToMarker(terminals, ess_bdr_markers, max_bdr_attr);
+
+  _phi_child = std::make_shared<mfem::ParGridFunction>(_h1_fe_space_child.get());
+  *_phi_child = 0.0;
+
+  mfem::ConstantCoefficient high_potential(0.5);
+  mfem::ConstantCoefficient low_potential(-0.5);
+  _phi_child->ProjectBdrCoefficient(high_potential, high_markers);
+  _phi_child->ProjectBdrCoefficient(low_potential, low_markers);
+
+  mfem::Array<int> ess_tdofs;
+  _h1_fe_space_child->GetEssentialTrueDofs(ess_bdr_markers, ess_tdofs);
+
+  mfem::ParBilinearForm a0(_h1_fe_space_child.get());
+  a0.AddDomainIntegrator(new mfem::DiffusionIntegrator(*_sigma));
+  a0.Assemble();
+
+  mfem::ParLinearForm b0(_h1_fe_space_child.get());
+  b0 = 0.0;
+
+  mfem::HypreParMatrix a0_mat;
+  mfem::Vector x0, rhs0;
+  a0.FormLinearSystem(ess_tdofs, *_phi_child, b0, a0_mat, x0, rhs0);
+
+  hephaestus::DefaultH1PCGSolver a0_solver(_solver_options, a0_mat);
+  a0_solver.Mult(rhs0, x0);
+  a0.RecoverFEMSolution(x0, b0, *_phi_child);
+
+  _grad_phi_child = std::make_shared<mfem::ParGridFunction>(_h_curl_fe_space_child.get());
+  mfem::ParDiscreteLinearOperator grad(_h1_fe_space_child.get(), _h_curl_fe_space_child.get());
+  grad.AddDomainInterpolator(new mfem::GradientInterpolator());
+  grad.Assemble();
+  grad.Mult(*_phi_child, *_grad_phi_child);
+
+  // Normalise the current through each coil, using its high potential
+  // electrode as a reference
+  std::vector<double> inv_flux;
+  for (const auto & coil : _coils)
+  {
+    const double flux = calcFlux(_grad_phi_child.get(), coil._electrodes.first, *_sigma);
+    inv_flux.push_back(1.0 / std::abs(flux));
+  }
+  ScaleByCoil(*_grad_phi_child, _h_curl_dof_coil, inv_flux, 1.0, *_grad_phi_child);
+  ScaleByCoil(*_phi_child, _h1_dof_coil, inv_flux, 1.0, *_phi_child);
+
+  if (_source_current_density)
+  {
+    _j_child = std::make_shared<mfem::ParGridFunction>(_h_div_fe_space_child.get());
+    *_j_child = 0.0;
+
+    hephaestus::GridFunctions aux_gf;
+    aux_gf.Register("grad_phi_child", _grad_phi_child);
+    aux_gf.Register("source_current_density", _j_child);
+
+    hephaestus::Coefficients aux_coef;
+    aux_coef._scalars.Register("electrical_conductivity", _sigma);
+
+    hephaestus::ScaledVectorGridFunctionAux current_density_auxsolver(
+        "grad_phi_child", "source_current_density", "electrical_conductivity", -1.0);
+    current_density_auxsolver.Init(aux_gf, aux_coef);
+    current_density_auxsolver.Solve();
+  }
+}
+
+void
+OpenCoilGroupSolver::BuildM1()
+{
+  _m1 = std::make_unique<mfem::ParBilinearForm>(_source_electric_field->ParFESpace());
+  hephaestus::AttrToMarker(_group_domains, _group_markers, _mesh_parent->attributes.Max());
+  _m1->AddDomainIntegrator(new mfem::VectorFEMassIntegrator(_sigma.get()), _group_markers);
+  _m1->Assemble();
+  _m1->Finalize();
+}
+
+} // namespace hephaestus
@@ -0,0 +1,125 @@
+#pragma once
+#include "flux_monitor_aux.hpp"
+#include "scaled_vector_gridfunction_aux.hpp"
+#include "source_base.hpp"
+#include <map>
+
+namespace hephaestus
+{
+
+// Open coil source for a group of coils, such as the coils of a winding. All
+// coils share one submesh and one set of FE spaces, the conductivity-weighted
+// Laplacian is assembled once and the terminal potentials of every coil are
+// found in a single preconditioned solve. Coils in a group must not touch each
+// other, and each coil must have its own electrode boundary attributes.
+class OpenCoilGroupSolver : public hephaestus::Source
+{
+
+public:
+  struct Coil
+  {
+    // Name of the coefficient holding the total current through the coil
+    std::string _i_coef_name;
+
+    // Domain attributes of the coil
+    mfem::Array<int> _coil_domains;
+
+    // High and low potential electrode boundary attributes
+    std::pair<int, int> _electrodes;
+  };
+
+  OpenCoilGroupSolver(std::string source_efield_gf_name,
+                      std::string phi_gf_name,
+                      std::string cond_coef_name,
+                      std::vector<Coil> coils,
+                      std::string source_jfield_gf_name = "",
+                      hephaestus::InputParameters solver_options =
+                          hephaestus::InputParameters({{"Tolerance", float(1.0e-20)},
+                                                       {"AbsTolerance", float(1.0e-20)},
+                                                       {"MaxIter", (unsigned int)1000},
+                                                       {"PrintLevel", logger.level()}}));
+
+  ~OpenCoilGroupSolver() override = default;
+
+  void Init(hephaestus::GridFunctions & gridfunctions,
+            const hephaestus::FESpaces & fespaces,
+            hephaestus::BCMap & bc_map,
+            hephaestus::Coefficients & coefficients) override;
+  void Apply(mfem::ParLinearForm * lf) override;
+  void SubtractSource(mfem::ParGridFunction * gf) override{};
+
+  // Initialises the child submesh covering all coils in the group.
+  void InitChildMesh();
+
+  // Creates the relevant FE Collections and Spaces for the child submesh, and
+  // the maps from their dofs to the coil they belong to.
+  void MakeFESpaces();
+
+  // Solves for the potential of every coil at once, and normalises each coil
+  // to unit current.
+  void SolvePotentials();
+
+  // Creates the mass matrix used in the Apply() method.
+  void BuildM1();
+
+private:
+  // Fills dof_coil with the index of the coil each dof of fes belongs to.
+  void MakeDofCoilMap(const mfem::ParFiniteElementSpace & fes, mfem::Array<int> & dof_coil) const;
+
+  // Parameters
+  std::vector<Coil> _coils;
+  mfem::Array<int> _group_domains;
+  mfem::Array<int> _group_markers;
+  std::map<int, int> _attr_to_coil;
+  hephaestus::InputParameters _solver_options;
+
+  int _order_h1;
+  int _order_hcurl;
+  int _order_hdiv;
+
+  std::shared_ptr<mfem::Coefficient> _sigma{nullptr};
+  std::vector<std::shared_ptr<mfem::Coefficient>> _itotals;
+
+  // Names
+  std::string _source_efield_gf_name;
+  std::string _phi_gf_name;
+  std::string _cond_coef_name;
+  std::string _source_jfield_gf_name;
+
+  // Parent mesh and fields
+  mfem::ParMesh * _mesh_parent{nullptr};
+  std::shared_ptr<mfem::ParGridFunction> _source_electric_field{nullptr};
+  std::shared_ptr<mfem::ParGridFunction> _phi_parent{nullptr};
+  std::shared_ptr<mfem::ParGridFunction> _source_current_density{nullptr};
+
+  // Child mesh and FE spaces
+  std::unique_ptr<mfem::ParSubMesh> _mesh_child{nullptr};
+
+  std::unique_ptr<mfem::H1_FECollection> _h1_fe_space_fec_child{nullptr};
+  std::unique_ptr<mfem::ParFiniteElementSpace> _h1_fe_space_child{nullptr};
+
+  std::unique_ptr<mfem::ND_FECollection> _h_curl_fe_space_fec_child{nullptr};
+  std::unique_ptr<mfem::ParFiniteElementSpace> _h_curl_fe_space_child{nullptr};
+
+  std::unique_ptr<mfem::RT_FECollection> _h_div_fe_space_fec_child{nullptr};
+  std::unique_ptr<mfem::ParFiniteElementSpace> _h_div_fe_space_child{nullptr};
+
+  // Coil index of each dof of the child FE spaces
+  mfem::Array<int> _h1_dof_coil;
+  mfem::Array<int> _h_curl_dof_coil;
+  mfem::Array<int> _h_div_dof_coil;
+
+  // Unit current fields of all coils on the child mesh. The coils do not
+  // share dofs, so the fields of all coils are stored together.
+  std::shared_ptr<mfem::ParGridFunction> _phi_child{nullptr};
+  std::shared_ptr<mfem::ParGridFunction> _grad_phi_child{nullptr};
+  std::shared_ptr<mfem::ParGridFunction> _j_child{nullptr};
+
+  // Conductivity-weighted mass matrix over all coils on the parent mesh
+  std::unique_ptr<mfem::ParBilinearForm> _m1{nullptr};
+
+  // Transfer maps from the child mesh to the parent mesh, reused by Apply
+  hephaestus::TransferMapCache _transfer_maps;
+};
+
+} // namespace hephaestus
@@ -59,31 +59,55 @@ ScalarPotentialSource::Init(hephaestus::GridFunctions & gridfunctions,
   _bc_map = &bc_map;
 
   _beta_coef = coefficients._scalars.Get(_coef_name);
+  _coefficients = &coefficients;
 
-  _a0 = std::make_unique<mfem::ParBilinearForm>(_h1_fe_space);
-  _a0->AddDomainIntegrator(new mfem::DiffusionIntegrator(*_beta_coef));
-  _a0->Assemble();
+  _b0 = std::make_unique<mfem::ParLinearForm>(_h1_fe_space);
+  _p_tdofs = std::make_unique<mfem::Vector>();
+  _b0_tdofs = std::make_unique<mfem::Vector>();
 
+  BuildH1Diffusion(_beta_coef);
   BuildGrad();
   BuildM1(_beta_coef);
-  // a0(p, p') = (β ∇ p, ∇ p')
+  _fe_space_sequence = _h1_fe_space->GetSequence();
+  _coef_sequence = _coefficients->GetSequence(_coef_name);
 
-  _b0 = std::make_unique<mfem::ParLinearForm>(_h1_fe_space);
-  _diffusion_mat = std::make_unique<mfem::HypreParMatrix>();
-  _p_tdofs = std::make_unique<mfem::Vector>();
-  _b0_tdofs = std::make_unique<mfem::Vector>();
+  // The diffusion solver is set up on the first call to Apply, once the
+  // essential dofs are known
+  _a0_solver.reset();
 }
 
 ScalarPotentialSource::~ScalarPotentialSource() = default;
 
+void
+ScalarPotentialSource::BuildH1Diffusion(mfem::Coefficient * Sigma)
+{
+  // a0(p, p') = (β ∇ p, ∇ p')
+  _a0 = std::make_unique<mfem::ParBilinearForm>(_h1_fe_space);
+  _a0->AddDomainIntegrator(new mfem::DiffusionIntegrator(*Sigma));
+  _a0->Assemble();
+  _a0->Finalize();
+}
+
+void
+ScalarPotentialSource::BuildDiffusionSolver(const mfem::Array<int> & ess_tdof_list)
+{
+  // The solver holds a reference to the matrix, so it is released first
+  _a0_solver.reset();
+
+  _poisson_ess_tdof_list = ess_tdof_list;
+  _diffusion_mat.reset(_a0->ParallelAssemble());
+  _diffusion_mat_e.reset(_diffusion_mat->EliminateRowsCols(_poisson_ess_tdof_list));
+
+  _a0_solver = std::make_unique<hephaestus::DefaultH1PCGSolver>(_solver_options, *_diffusion_mat);
+}
+
 void
 ScalarPotentialSource::BuildM1(mfem::Coefficient * Sigma)
 {
   _m1 = std::make_unique<mfem::ParBilinearForm>(_h_curl_fe_space);
   _m1->AddDomainIntegrator(new mfem::VectorFEMassIntegrator(*Sigma));
   _m1->Assemble();
-
-  // Don't finalize or parallel assemble this is done in FormLinearSystem.
+  _m1->Finalize();
 }
 
 void
@@ -106,31 +130,48 @@ ScalarPotentialSource::Apply(mfem::ParLinearForm * lf)
   mfem::ParGridFunction phi_gf(_h1_fe_space);
   mfem::Array<int> poisson_ess_tdof_list;
   phi_gf = 0.0;
+  _b0->Update();
   *_b0 = 0.0;
   _bc_map->ApplyEssentialBCs(
       _phi_gf_name, poisson_ess_tdof_list, phi_gf, (_h1_fe_space->GetParMesh()));
   _bc_map->ApplyIntegratedBCs(_phi_gf_name, *_b0, (_h1_fe_space->GetParMesh()));
   _b0->Assemble();
 
-  _a0->Update();
-  _a0->Assemble();
-  _a0->FormLinearSystem(
-      poisson_ess_tdof_list, phi_gf, *_b0, *_diffusion_mat, *_p_tdofs, *_b0_tdofs);
+  // Rebuild the operators only if the mesh, the coefficient or the set of
+  // essential dofs have changed. The decision must be the same on all ranks.
+  const bool mesh_changed = _h1_fe_space->GetSequence() != _fe_space_sequence;
+  const bool coef_changed = _coefficients->GetSequence(_coef_name) != _coef_sequence;
+  int rebuild = mesh_changed || coef_changed || _a0_solver == nullptr ||
+                !(poisson_ess_tdof_list == _poisson_ess_tdof_list);
+  MPI_Allreduce(MPI_IN_PLACE, &rebuild, 1, MPI_INT, MPI_LOR, _h1_fe_space->GetComm());
 
-  if (_a0_solver == nullptr)
+  if (rebuild)
   {
-    _a0_solver = std::make_unique<hephaestus::DefaultH1PCGSolver>(_solver_options, *_diffusion_mat);
+    if (mesh_changed || coef_changed)
+    {
+      BuildH1Diffusion(_beta_coef);
+      BuildGrad();
+      BuildM1(_beta_coef);
+    }
+    BuildDiffusionSolver(poisson_ess_tdof_list);
+
+    _fe_space_sequence = _h1_fe_space->GetSequence();
+    _coef_sequence = _coefficients->GetSequence(_coef_name);
   }
+
+  // Only the right hand side depends on the boundary values
+  _b0_tdofs->SetSize(_h1_fe_space->GetTrueVSize());
+  _b0->ParallelAssemble(*_b0_tdofs);
+  phi_gf.GetTrueDofs(*_p_tdofs);
+  mfem::EliminateBC(
+      *_diffusion_mat, *_diffusion_mat_e, _poisson_ess_tdof_list, *_p_tdofs, *_b0_tdofs);
+
   // Solve
   _a0_solver->Mult(*_b0_tdofs, *_p_tdofs);
-
-  // "undo" the static condensation saving result in grid function dP
-  _a0->RecoverFEMSolution(*_p_tdofs, *_b0, *_phi);
+  _phi->SetFromTrueDofs(*_p_tdofs);
 
   _grad->Mult(*_phi, *_grad_phi);
 
-  _m1->Update();
-  _m1->Assemble();
   _m1->AddMult(*_grad_phi, *lf, _source_sign);
 }
 
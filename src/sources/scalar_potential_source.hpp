@@ -30,6 +30,9 @@ public:
   void BuildWeakDiv();
   void BuildGrad();
 
+  // Assembles and eliminates the diffusion matrix, and sets up its solver.
+  void BuildDiffusionSolver(const mfem::Array<int> & ess_tdof_list);
+
   std::string _grad_phi_gf_name;
   std::string _phi_gf_name;
   std::string _hcurl_fespace_name;
@@ -53,11 +56,18 @@ public:
   std::unique_ptr<mfem::ParDiscreteLinearOperator> _grad{nullptr};
 
   std::unique_ptr<mfem::HypreParMatrix> _diffusion_mat{nullptr};
+  std::unique_ptr<mfem::HypreParMatrix> _diffusion_mat_e{nullptr};
+  mfem::Array<int> _poisson_ess_tdof_list;
   std::unique_ptr<mfem::Vector> _p_tdofs{nullptr};
   std::unique_ptr<mfem::Vector> _b0_tdofs{nullptr};
 
-  mutable mfem::HypreSolver * _amg_a0{nullptr};
-  mutable std::unique_ptr<hephaestus::DefaultH1PCGSolver> _a0_solver{nullptr};
+  std::unique_ptr<hephaestus::DefaultH1PCGSolver> _a0_solver{nullptr};
+
+  // Operators are reused across Apply calls until the FE space sequence
+  // number, the conductivity coefficient or the essential dofs change.
+  long _fe_space_sequence{-1};
+  hephaestus::Coefficients * _coefficients{nullptr};
+  long _coef_sequence{-1};
 
   std::unique_ptr<mfem::ParLinearForm> _b0{nullptr};
   std::shared_ptr<mfem::ParGridFunction> _grad_phi{nullptr};
@@ -3,6 +3,7 @@
 #include "div_free_source.hpp"
 #include "named_fields_map.hpp"
 #include "open_coil.hpp"
+#include "open_coil_group.hpp"
 #include "scalar_potential_source.hpp"
 
 namespace hephaestus
@@ -1,5 +1,7 @@
 #include "utils.hpp"
 
+#include <limits>
+
 namespace hephaestus
 {
 
@@ -36,6 +38,54 @@ InheritBdrAttributes(const mfem::ParMesh * parent_mesh, mfem::ParSubMesh * child
   child_mesh->SetAttributes();
 }
 
+int
+LowestRankWith(bool condition, MPI_Comm comm)
+{
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  int local_rank = condition ? rank : std::numeric_limits<int>::max();
+  int lowest_rank;
+  MPI_Allreduce(&local_rank, &lowest_rank, 1, MPI_INT, MPI_MIN, comm);
+
+  return (lowest_rank == std::numeric_limits<int>::max()) ? -1 : lowest_rank;
+}
+
+void
+CompressedVector::Compress(const mfem::Vector & v)
+{
+  _indices.SetSize(0);
+  for (int i = 0; i < v.Size(); ++i)
+  {
+    if (v(i) != 0.0)
+      _indices.Append(i);
+  }
+
+  _values.SetSize(_indices.Size());
+  v.GetSubVector(_indices, _values);
+}
+
+void
+CompressedVector::AddTo(double a, mfem::Vector & v) const
+{
+  for (int k = 0; k < _indices.Size(); ++k)
+    v(_indices[k]) += a * _values(k);
+}
+
+void
+TransferMapCache::Transfer(const mfem::ParGridFunction & src, mfem::ParGridFunction & dst)
+{
+  const auto key = std::make_pair(src.ParFESpace(), dst.ParFESpace());
+
+  auto it = _maps.find(key);
+  if (it == _maps.end())
+  {
+    it = _maps.emplace(key, std::make_unique<mfem::ParTransferMap>(src, dst)).first;
+  }
+
+  it->second->Transfer(src, dst);
+}
+
 void
 AttrToMarker(const mfem::Array<int> attr_list, mfem::Array<int> & marker_list, int max_attr)
 {
@@ -4,6 +4,7 @@
 #include "helmholtz_projector.hpp"
 #include "hephaestus_solvers.hpp"
 #include "inputs.hpp"
+#include <map>
 
 namespace hephaestus
 {
@@ -19,6 +20,10 @@ void IfDelete(T * ptr);
 // deprecated.
 void InheritBdrAttributes(const mfem::ParMesh * parent_mesh, mfem::ParSubMesh * child_mesh);
 
+// Returns the lowest rank of comm on which condition holds, or -1 if it holds on
+// no rank. Collective on comm.
+int LowestRankWith(bool condition, MPI_Comm comm);
+
 // Takes in an array of attributes and turns into a marker array.
 void AttrToMarker(const mfem::Array<int> attr_list, mfem::Array<int> & marker_list, int max_attr);
 
@@ -34,4 +39,39 @@ void CleanDivergence(hephaestus::GridFunctions & gfs,
                      const std::string scalar_gf_name,
                      hephaestus::InputParameters solve_pars);
 
+// Stores only the nonzero entries of a vector, for fields that are supported on
+// a small region of a large mesh, such as the unit-current fields of a coil.
+class CompressedVector
+{
+public:
+  // Stores the nonzero entries of v.
+  void Compress(const mfem::Vector & v);
+
+  // v += a * this, touching only the stored entries.
+  void AddTo(double a, mfem::Vector & v) const;
+
+  [[nodiscard]] int NumNonZeros() const { return _indices.Size(); }
+
+private:
+  mfem::Array<int> _indices;
+  mfem::Vector _values;
+};
+
+// Caches the ParTransferMaps between pairs of FE spaces on a mesh and its
+// submeshes, so that repeated transfers only cost the data exchange. The cache
+// is keyed on the spaces, which must outlive it or be cleared from it.
+class TransferMapCache
+{
+public:
+  // Transfers src to dst, as ParSubMesh::Transfer does.
+  void Transfer(const mfem::ParGridFunction & src, mfem::ParGridFunction & dst);
+
+  void Clear() { _maps.clear(); }
+
+private:
+  std::map<std::pair<const mfem::ParFiniteElementSpace *, const mfem::ParFiniteElementSpace *>,
+           std::unique_ptr<mfem::ParTransferMap>>
+      _maps;
+};
+
 } // namespace hephaestus
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "hephaestus.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// Transient A form problem on a hexahedral mesh, solved with each of the
+// AssemblyLevel solver options.
+class TestAFormAssemblyLevel
+{
+protected:
+  static void AdotBC(const mfem::Vector & x, double t, mfem::Vector & A)
+  {
+    A(0) = sin(x(1) * M_PI) * sin(x(2) * M_PI);
+    A(1) = 0;
+    A(2) = 0;
+  }
+
+  static void SourceField(const mfem::Vector & x, double t, mfem::Vector & f)
+  {
+    f(0) = (1.0 + 2.0 * M_PI * M_PI * t) * sin(M_PI * x(1)) * sin(M_PI * x(2));
+    f(1) = 0;
+    f(2) = 0;
+  }
+
+  // Solution after num_steps time steps with the given AssemblyLevel. Below
+  // Full, the Jacobian is applied matrix-free and preconditioned on its LOR
+  // counterpart.
+  mfem::Vector Solve(const std::string & assembly_level, int num_steps)
+  {
+    hephaestus::Coefficients coefficients;
+    coefficients._scalars.Register("electrical_conductivity",
+                                   std::make_shared<mfem::ConstantCoefficient>(1.0));
+    coefficients._scalars.Register("magnetic_permeability",
+                                   std::make_shared<mfem::ConstantCoefficient>(1.0));
+
+    hephaestus::BCMap bc_map;
+    auto adot_vec_coef = std::make_shared<mfem::VectorFunctionCoefficient>(3, AdotBC);
+    coefficients._vectors.Register("surface_tangential_dAdt", adot_vec_coef);
+    bc_map.Register("tangential_dAdt",
+                    std::make_shared<hephaestus::VectorDirichletBC>(
+                        std::string("dmagnetic_vector_potential_dt"),
+                        mfem::Array<int>({1, 2, 3, 4, 5, 6}),
+                        adot_vec_coef.get()));
+
+    hephaestus::Sources sources;
+    coefficients._vectors.Register(
+        "source", std::make_shared<mfem::VectorFunctionCoefficient>(3, SourceField));
+    hephaestus::InputParameters current_solver_options;
+    current_solver_options.SetParam("Tolerance", float(1.0e-12));
+    current_solver_options.SetParam("MaxIter", (unsigned int)200);
+    sources.Register("source",
+                     std::make_shared<hephaestus::DivFreeSource>("source",
+                                                                 "source",
+                                                                 "HCurl",
+                                                                 "H1",
+                                                                 "_source_potential",
+                                                                 current_solver_options,
+                                                                 false));
+
+    hephaestus::InputParameters solver_options;
+    solver_options.SetParam("Tolerance", float(1.0e-12));
+    solver_options.SetParam("AbsTolerance", float(1.0e-20));
+    solver_options.SetParam("MaxIter", (unsigned int)1000);
+    solver_options.SetParam("PrintLevel", 0);
+    solver_options.SetParam("AssemblyLevel", assembly_level);
+
+    mfem::Mesh mesh = mfem::Mesh::MakeCartesian3D(4, 4, 4, mfem::Element::HEXAHEDRON);
+    auto pmesh = std::make_shared<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+
+    auto problem_builder = std::make_unique<hephaestus::AFormulation>("magnetic_reluctivity",
+                                                                      "magnetic_permeability",
+                                                                      "electrical_conductivity",
+                                                                      "magnetic_vector_potential");
+    problem_builder->SetMesh(pmesh);
+    problem_builder->AddFESpace(std::string("HCurl"), std::string("ND_3D_P2"));
+    problem_builder->AddFESpace(std::string("H1"), std::string("H1_3D_P2"));
+    problem_builder->AddGridFunction("magnetic_vector_potential", "HCurl");
+    problem_builder->SetBoundaryConditions(bc_map);
+    problem_builder->SetCoefficients(coefficients);
+    problem_builder->SetSources(sources);
+    problem_builder->SetSolverOptions(solver_options);
+
+    hephaestus::ProblemBuildSequencer sequencer(problem_builder.get());
+    sequencer.ConstructEquationSystemProblem();
+    std::unique_ptr<hephaestus::TimeDomainProblem> problem = problem_builder->ReturnProblem();
+
+    hephaestus::InputParameters exec_params;
+    exec_params.SetParam("TimeStep", float(0.05));
+    exec_params.SetParam("StartTime", float(0.00));
+    exec_params.SetParam("EndTime", float(0.05 * num_steps));
+    exec_params.SetParam("Problem", problem.get());
+    auto executioner = std::make_unique<hephaestus::TransientExecutioner>(exec_params);
+
+    for (int step = 0; step < num_steps; ++step)
+    {
+      executioner->Solve();
+    }
+    return problem->_gridfunctions.GetRef("magnetic_vector_potential");
+  }
+};
+
+TEST_CASE_METHOD(TestAFormAssemblyLevel, "TestAFormAssemblyLevel", "[CheckRun]")
+{
+  const int num_steps = 3;
+  const mfem::Vector full = Solve("Full", num_steps);
+  const double full_norm = mfem::ParNormlp(full, 2, MPI_COMM_WORLD);
+  REQUIRE(full_norm > 0.0);
+
+  // Matrix-free solves with the LOR preconditioner match the fully assembled
+  // solve
+  for (const std::string assembly_level : {"Partial", "Element"})
+  {
+    mfem::Vector difference(Solve(assembly_level, num_steps));
+    difference -= full;
+    REQUIRE_THAT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) / full_norm,
+                 Catch::Matchers::WithinAbs(0.0, 1.0e-8));
+  }
+}
@@ -0,0 +1,134 @@
+#include "hephaestus.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+extern const char * DATA_DIR;
+
+// Transient A form problem with a source growing linearly in time, so that the
+// time derivative of the solution varies smoothly between steps.
+class TestAFormInitialGuess
+{
+protected:
+  static void AdotBC(const mfem::Vector & x, double t, mfem::Vector & A)
+  {
+    A(0) = sin(x(1) * M_PI) * sin(x(2) * M_PI);
+    A(1) = 0;
+    A(2) = 0;
+  }
+
+  static void SourceField(const mfem::Vector & x, double t, mfem::Vector & f)
+  {
+    f(0) = (1.0 + 2.0 * M_PI * M_PI * t) * sin(M_PI * x(1)) * sin(M_PI * x(2));
+    f(1) = 0;
+    f(2) = 0;
+  }
+
+  struct Run
+  {
+    std::vector<int> _iterations;
+    mfem::Vector _solution;
+  };
+
+  // Solve num_steps time steps with the given InitialGuess solver option,
+  // recording the Krylov iterations of every step
+  Run Solve(const std::string & initial_guess, int num_steps)
+  {
+    hephaestus::Coefficients coefficients;
+    coefficients._scalars.Register("electrical_conductivity",
+                                   std::make_shared<mfem::ConstantCoefficient>(1.0));
+    coefficients._scalars.Register("magnetic_permeability",
+                                   std::make_shared<mfem::ConstantCoefficient>(1.0));
+
+    hephaestus::BCMap bc_map;
+    auto adot_vec_coef = std::make_shared<mfem::VectorFunctionCoefficient>(3, AdotBC);
+    coefficients._vectors.Register("surface_tangential_dAdt", adot_vec_coef);
+    bc_map.Register("tangential_dAdt",
+                    std::make_shared<hephaestus::VectorDirichletBC>(
+                        std::string("dmagnetic_vector_potential_dt"),
+                        mfem::Array<int>({1, 2, 3}),
+                        adot_vec_coef.get()));
+
+    hephaestus::Sources sources;
+    coefficients._vectors.Register(
+        "source", std::make_shared<mfem::VectorFunctionCoefficient>(3, SourceField));
+    hephaestus::InputParameters current_solver_options;
+    current_solver_options.SetParam("Tolerance", float(1.0e-12));
+    current_solver_options.SetParam("MaxIter", (unsigned int)200);
+    sources.Register("source",
+                     std::make_shared<hephaestus::DivFreeSource>("source",
+                                                                 "source",
+                                                                 "_HCurlFESpace",
+                                                                 "H1",
+                                                                 "_source_potential",
+                                                                 current_solver_options,
+                                                                 false));
+
+    hephaestus::InputParameters solver_options;
+    solver_options.SetParam("Tolerance", float(1.0e-12));
+    solver_options.SetParam("AbsTolerance", float(1.0e-20));
+    solver_options.SetParam("MaxIter", (unsigned int)1000);
+    solver_options.SetParam("PrintLevel", 0);
+    solver_options.SetParam("InitialGuess", initial_guess);
+
+    mfem::Mesh mesh((std::string(DATA_DIR) + std::string("./beam-tet.mesh")).c_str(), 1, 1);
+    auto pmesh = std::make_shared<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+
+    auto problem_builder = std::make_unique<hephaestus::AFormulation>("magnetic_reluctivity",
+                                                                      "magnetic_permeability",
+                                                                      "electrical_conductivity",
+                                                                      "magnetic_vector_potential");
+    problem_builder->SetMesh(pmesh);
+    problem_builder->AddFESpace(std::string("HCurl"), std::string("ND_3D_P2"));
+    problem_builder->AddFESpace(std::string("H1"), std::string("H1_3D_P2"));
+    problem_builder->SetBoundaryConditions(bc_map);
+    problem_builder->SetCoefficients(coefficients);
+    problem_builder->SetSources(sources);
+    problem_builder->SetSolverOptions(solver_options);
+
+    hephaestus::ProblemBuildSequencer sequencer(problem_builder.get());
+    sequencer.ConstructEquationSystemProblem();
+    std::unique_ptr<hephaestus::TimeDomainProblem> problem = problem_builder->ReturnProblem();
+
+    hephaestus::InputParameters exec_params;
+    exec_params.SetParam("TimeStep", float(0.05));
+    exec_params.SetParam("StartTime", float(0.00));
+    exec_params.SetParam("EndTime", float(0.05 * num_steps));
+    exec_params.SetParam("Problem", problem.get());
+    auto executioner = std::make_unique<hephaestus::TransientExecutioner>(exec_params);
+
+    Run run;
+    for (int step = 0; step < num_steps; ++step)
+    {
+      executioner->Solve();
+      run._iterations.push_back(hephaestus::GetNumIterations(*problem->_jacobian_solver));
+    }
+    run._solution = problem->_gridfunctions.GetRef("magnetic_vector_potential");
+    return run;
+  }
+};
+
+TEST_CASE_METHOD(TestAFormInitialGuess, "TestAFormInitialGuess", "[CheckRun]")
+{
+  const int num_steps = 6;
+  const auto reference = Solve("None", num_steps);
+  const auto extrapolated = Solve("Linear", num_steps);
+
+  // Once two previous solutions are available, the extrapolated initial guess
+  // saves Krylov iterations
+  int reference_iterations = 0;
+  int extrapolated_iterations = 0;
+  for (int step = 2; step < num_steps; ++step)
+  {
+    REQUIRE(reference._iterations[step] > 0);
+    reference_iterations += reference._iterations[step];
+    extrapolated_iterations += extrapolated._iterations[step];
+  }
+  REQUIRE(extrapolated_iterations < reference_iterations);
+
+  // To the same solution
+  mfem::Vector difference(extrapolated._solution);
+  difference -= reference._solution;
+  REQUIRE_THAT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) /
+                   mfem::ParNormlp(reference._solution, 2, MPI_COMM_WORLD),
+               Catch::Matchers::WithinAbs(0.0, 1.0e-8));
+}
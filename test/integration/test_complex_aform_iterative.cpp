@@ -0,0 +1,154 @@
+#include "hephaestus.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+extern const char * DATA_DIR;
+
+// Eddy current problem in a rod driven by a potential difference, solved with
+// each of the ComplexSolver options.
+class TestComplexAFormIterative
+{
+protected:
+  static double PotentialHigh(const mfem::Vector & x, double t) { return 2.0; }
+  static double PotentialGround(const mfem::Vector & x, double t) { return 0.0; }
+  static void ABc(const mfem::Vector & x, mfem::Vector & A)
+  {
+    A.SetSize(3);
+    A = 0.0;
+  }
+
+  std::unique_ptr<hephaestus::SteadyStateProblem> BuildProblem(const std::string & complex_solver)
+  {
+    double sigma = 2.0 * M_PI * 10;
+
+    // Conductive enough for the vector potential in the air to be well
+    // determined, so that the solutions can be compared directly
+    double sigma_air = 1.0e-2 * sigma;
+
+    hephaestus::Subdomain wire("wire", 1);
+    wire._scalar_coefficients.Register("electrical_conductivity",
+                                       std::make_shared<mfem::ConstantCoefficient>(sigma));
+    hephaestus::Subdomain air("air", 2);
+    air._scalar_coefficients.Register("electrical_conductivity",
+                                      std::make_shared<mfem::ConstantCoefficient>(sigma_air));
+    hephaestus::Coefficients coefficients(std::vector<hephaestus::Subdomain>({wire, air}));
+
+    coefficients._scalars.Register("frequency",
+                                   std::make_shared<mfem::ConstantCoefficient>(1.0 / 60.0));
+    coefficients._scalars.Register("dielectric_permittivity",
+                                   std::make_shared<mfem::ConstantCoefficient>(0.0));
+    coefficients._scalars.Register("magnetic_permeability",
+                                   std::make_shared<mfem::ConstantCoefficient>(1.0));
+    coefficients._vectors.Register("ABc",
+                                   std::make_shared<mfem::VectorFunctionCoefficient>(3, ABc));
+
+    hephaestus::BCMap bc_map;
+    bc_map.Register(
+        "tangential_A",
+        std::make_shared<hephaestus::VectorDirichletBC>(std::string("magnetic_vector_potential"),
+                                                        mfem::Array<int>({1, 2, 3}),
+                                                        coefficients._vectors.Get("ABc"),
+                                                        coefficients._vectors.Get("ABc")));
+
+    auto potential_src = std::make_shared<mfem::FunctionCoefficient>(PotentialHigh);
+    coefficients._scalars.Register("source_potential", potential_src);
+    bc_map.Register(
+        "high_potential",
+        std::make_shared<hephaestus::ScalarDirichletBC>(
+            std::string("electric_potential"), mfem::Array<int>({1}), potential_src.get()));
+
+    auto potential_ground = std::make_shared<mfem::FunctionCoefficient>(PotentialGround);
+    coefficients._scalars.Register("ground_potential", potential_ground);
+    bc_map.Register(
+        "ground_potential",
+        std::make_shared<hephaestus::ScalarDirichletBC>(
+            std::string("electric_potential"), mfem::Array<int>({2}), potential_ground.get()));
+
+    hephaestus::Sources sources;
+    hephaestus::InputParameters current_solver_options;
+    current_solver_options.SetParam("Tolerance", float(1.0e-12));
+    current_solver_options.SetParam("MaxIter", (unsigned int)1000);
+    sources.Register("source",
+                     std::make_shared<hephaestus::ScalarPotentialSource>("source",
+                                                                         "electric_potential",
+                                                                         "HCurl",
+                                                                         "H1",
+                                                                         "electrical_conductivity",
+                                                                         -1,
+                                                                         current_solver_options));
+
+    hephaestus::InputParameters solver_options;
+    solver_options.SetParam("ComplexSolver", complex_solver);
+    solver_options.SetParam("Tolerance", float(1.0e-12));
+    solver_options.SetParam("AbsTolerance", float(1.0e-20));
+    solver_options.SetParam("MaxIter", (unsigned int)2000);
+    solver_options.SetParam("KDim", (unsigned int)100);
+    solver_options.SetParam("PrintLevel", -1);
+
+    mfem::Mesh mesh((std::string(DATA_DIR) + std::string("./cylinder-hex-q2.gen")).c_str(), 1, 1);
+    auto pmesh = std::make_shared<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+
+    auto problem_builder =
+        std::make_unique<hephaestus::ComplexAFormulation>("magnetic_reluctivity",
+                                                          "electrical_conductivity",
+                                                          "dielectric_permittivity",
+                                                          "frequency",
+                                                          "magnetic_vector_potential",
+                                                          "magnetic_vector_potential_real",
+                                                          "magnetic_vector_potential_imag");
+
+    hephaestus::AuxSolvers preprocessors;
+    hephaestus::AuxSolvers postprocessors;
+    hephaestus::Outputs outputs;
+
+    problem_builder->SetMesh(pmesh);
+    problem_builder->AddFESpace(std::string("HCurl"), std::string("ND_3D_P1"));
+    problem_builder->AddFESpace(std::string("H1"), std::string("H1_3D_P1"));
+    problem_builder->AddGridFunction("magnetic_vector_potential_real", "HCurl");
+    problem_builder->AddGridFunction("magnetic_vector_potential_imag", "HCurl");
+    problem_builder->SetBoundaryConditions(bc_map);
+    problem_builder->SetAuxSolvers(preprocessors);
+    problem_builder->SetCoefficients(coefficients);
+    problem_builder->SetPostprocessors(postprocessors);
+    problem_builder->SetSources(sources);
+    problem_builder->SetOutputs(outputs);
+    problem_builder->SetSolverOptions(solver_options);
+
+    hephaestus::ProblemBuildSequencer sequencer(problem_builder.get());
+    sequencer.ConstructOperatorProblem();
+    return problem_builder->ReturnProblem();
+  }
+
+  // Solution as a single vector [real; imag]
+  static mfem::Vector Solve(hephaestus::SteadyStateProblem & problem)
+  {
+    hephaestus::InputParameters exec_params;
+    exec_params.SetParam("Problem", &problem);
+    auto executioner = std::make_unique<hephaestus::SteadyExecutioner>(exec_params);
+    executioner->Execute();
+
+    const auto & a_real = problem._gridfunctions.GetRef("magnetic_vector_potential_real");
+    const auto & a_imag = problem._gridfunctions.GetRef("magnetic_vector_potential_imag");
+    mfem::Vector solution(a_real.Size() + a_imag.Size());
+    solution.SetVector(a_real, 0);
+    solution.SetVector(a_imag, a_real.Size());
+    return solution;
+  }
+};
+
+TEST_CASE_METHOD(TestComplexAFormIterative, "TestComplexAFormIterative", "[CheckRun]")
+{
+  auto direct_problem = BuildProblem("Direct");
+  const mfem::Vector direct_solution = Solve(*direct_problem);
+
+  auto iterative_problem = BuildProblem("Iterative");
+  const mfem::Vector iterative_solution = Solve(*iterative_problem);
+
+  // The block-preconditioned GMRES solve converges to the direct solution
+  mfem::Vector difference(iterative_solution);
+  difference -= direct_solution;
+  const double direct_norm = mfem::ParNormlp(direct_solution, 2, MPI_COMM_WORLD);
+  REQUIRE(direct_norm > 0.0);
+  REQUIRE_THAT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) / direct_norm,
+               Catch::Matchers::WithinAbs(0.0, 1.0e-6));
+}
@@ -0,0 +1,152 @@
+#include "hephaestus.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+extern const char * DATA_DIR;
+
+class TestComplexFrequencySweep
+{
+protected:
+  static void EBCR(const mfem::Vector & x, mfem::Vector & E)
+  {
+    E.SetSize(3);
+    E = 0.0;
+  }
+
+  static void EBCI(const mfem::Vector & x, mfem::Vector & E)
+  {
+    E.SetSize(3);
+    E = 0.0;
+  }
+
+  // Tangential field driving the waveguide at its input port
+  static void EPortR(const mfem::Vector & x, mfem::Vector & E)
+  {
+    E.SetSize(3);
+    E = 0.0;
+    E(2) = 1.0;
+  }
+
+  inline static const double epsilon0_ = 8.8541878176e-12; // F/m;
+  inline static const double mu0_ = 4.0e-7 * M_PI;         // H/m;
+
+  std::unique_ptr<hephaestus::SteadyStateProblem> BuildProblem(double frequency)
+  {
+    hephaestus::Subdomain air("air", 1);
+    hephaestus::Coefficients coefficients(std::vector<hephaestus::Subdomain>({air}));
+
+    coefficients._scalars.Register("frequency",
+                                   std::make_shared<mfem::ConstantCoefficient>(frequency));
+    coefficients._scalars.Register("magnetic_permeability",
+                                   std::make_shared<mfem::ConstantCoefficient>(mu0_));
+    coefficients._scalars.Register("dielectric_permittivity",
+                                   std::make_shared<mfem::ConstantCoefficient>(epsilon0_));
+    coefficients._scalars.Register("electrical_conductivity",
+                                   std::make_shared<mfem::ConstantCoefficient>(0.1));
+
+    coefficients._vectors.Register("EBCR",
+                                   std::make_shared<mfem::VectorFunctionCoefficient>(3, EBCR));
+    coefficients._vectors.Register("EBCI",
+                                   std::make_shared<mfem::VectorFunctionCoefficient>(3, EBCI));
+    coefficients._vectors.Register("EPortR",
+                                   std::make_shared<mfem::VectorFunctionCoefficient>(3, EPortR));
+
+    // Frequency-independent boundary conditions only: a driven input port and
+    // perfectly conducting walls elsewhere
+    hephaestus::BCMap bc_map;
+    mfem::Array<int> wall_attr;
+    wall_attr.Append(1);
+    wall_attr.Append(3);
+    bc_map.Register(
+        "tangential_E",
+        std::make_shared<hephaestus::VectorDirichletBC>(std::string("electric_field"),
+                                                        wall_attr,
+                                                        coefficients._vectors.Get("EBCR"),
+                                                        coefficients._vectors.Get("EBCI")));
+    mfem::Array<int> port_attr;
+    port_attr.Append(2);
+    bc_map.Register(
+        "port_E",
+        std::make_shared<hephaestus::VectorDirichletBC>(std::string("electric_field"),
+                                                        port_attr,
+                                                        coefficients._vectors.Get("EPortR"),
+                                                        coefficients._vectors.Get("EBCI")));
+
+    mfem::Mesh mesh((std::string(DATA_DIR) + std::string("./irises.g")).c_str(), 1, 1);
+    auto pmesh = std::make_shared<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+
+    auto problem_builder =
+        std::make_unique<hephaestus::ComplexEFormulation>("magnetic_reluctivity",
+                                                          "electrical_conductivity",
+                                                          "dielectric_permittivity",
+                                                          "frequency",
+                                                          "electric_field",
+                                                          "electric_field_real",
+                                                          "electric_field_imag");
+
+    hephaestus::AuxSolvers preprocessors;
+    hephaestus::AuxSolvers postprocessors;
+    hephaestus::Sources sources;
+    hephaestus::Outputs outputs;
+
+    problem_builder->SetMesh(pmesh);
+    problem_builder->SetBoundaryConditions(bc_map);
+    problem_builder->SetAuxSolvers(preprocessors);
+    problem_builder->SetCoefficients(coefficients);
+    problem_builder->SetPostprocessors(postprocessors);
+    problem_builder->SetSources(sources);
+    problem_builder->SetOutputs(outputs);
+    problem_builder->SetSolverOptions(hephaestus::InputParameters());
+
+    hephaestus::ProblemBuildSequencer sequencer(problem_builder.get());
+    sequencer.ConstructOperatorProblem();
+    return problem_builder->ReturnProblem();
+  }
+
+  // Solution as a single vector [real; imag]
+  static mfem::Vector Solution(const hephaestus::SteadyStateProblem & problem)
+  {
+    const auto & e_real = problem._gridfunctions.GetRef("electric_field_real");
+    const auto & e_imag = problem._gridfunctions.GetRef("electric_field_imag");
+    mfem::Vector solution(e_real.Size() + e_imag.Size());
+    solution.SetVector(e_real, 0);
+    solution.SetVector(e_imag, e_real.Size());
+    return solution;
+  }
+};
+
+TEST_CASE_METHOD(TestComplexFrequencySweep, "TestComplexFrequencySweep", "[CheckRun]")
+{
+  // Full solves at the outer frequencies build the reduced basis; the
+  // frequency between them is then solved in the reduced basis.
+  const double f_low = 9.2e9;
+  const double f_high = 9.4e9;
+  const double f_mid = 9.3e9;
+  const float tolerance = 1.0e-3;
+
+  auto sweep_problem = BuildProblem(f_low);
+  hephaestus::InputParameters sweep_params;
+  sweep_params.SetParam("Problem", sweep_problem.get());
+  sweep_params.SetParam("Frequencies", std::vector<double>({f_low, f_high, f_mid}));
+  sweep_params.SetParam("ReducedBasisTolerance", tolerance);
+  auto sweep = std::make_unique<hephaestus::FrequencySweepExecutioner>(sweep_params);
+  sweep->Execute();
+
+  REQUIRE(sweep->GetNumFullSolves() == 2);
+  REQUIRE(sweep->GetNumReducedSolves() == 1);
+  const mfem::Vector reduced_solution = Solution(*sweep_problem);
+
+  // Full solve of the same problem at the intermediate frequency
+  auto full_problem = BuildProblem(f_mid);
+  hephaestus::InputParameters full_params;
+  full_params.SetParam("Problem", full_problem.get());
+  auto full = std::make_unique<hephaestus::SteadyExecutioner>(full_params);
+  full->Execute();
+  const mfem::Vector full_solution = Solution(*full_problem);
+
+  mfem::Vector difference(reduced_solution);
+  difference -= full_solution;
+  const double relative_error = mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) /
+                                mfem::ParNormlp(full_solution, 2, MPI_COMM_WORLD);
+  REQUIRE_THAT(relative_error, Catch::Matchers::WithinAbs(0.0, 10.0 * tolerance));
+}
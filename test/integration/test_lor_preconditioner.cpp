@@ -0,0 +1,188 @@
+#include "hephaestus.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// HCurl and statics problems on a hexahedral mesh, solved with and without the
+// LORPreconditioner solver option.
+class TestLORPreconditioner
+{
+protected:
+  static void AdotBC(const mfem::Vector & x, double t, mfem::Vector & A)
+  {
+    A(0) = sin(x(1) * M_PI) * sin(x(2) * M_PI);
+    A(1) = 0;
+    A(2) = 0;
+  }
+
+  static void ABC(const mfem::Vector & x, mfem::Vector & A)
+  {
+    A.SetSize(3);
+    A = 0.0;
+  }
+
+  // Divergence-free source field
+  static void SourceField(const mfem::Vector & x, double t, mfem::Vector & f)
+  {
+    f(0) = (1.0 + 2.0 * M_PI * M_PI * t) * sin(M_PI * x(1)) * sin(M_PI * x(2));
+    f(1) = 0;
+    f(2) = 0;
+  }
+
+  static hephaestus::InputParameters SolverOptions(bool use_lor)
+  {
+    hephaestus::InputParameters solver_options;
+    solver_options.SetParam("Tolerance", float(1.0e-12));
+    solver_options.SetParam("AbsTolerance", float(1.0e-20));
+    solver_options.SetParam("MaxIter", (unsigned int)1000);
+    solver_options.SetParam("KDim", (unsigned int)100);
+    solver_options.SetParam("PrintLevel", 0);
+    solver_options.SetParam("LORPreconditioner", use_lor);
+    return solver_options;
+  }
+
+  static std::shared_ptr<hephaestus::DivFreeSource>
+  MakeSource(hephaestus::Coefficients & coefficients)
+  {
+    coefficients._vectors.Register(
+        "source", std::make_shared<mfem::VectorFunctionCoefficient>(3, SourceField));
+    hephaestus::InputParameters current_solver_options;
+    current_solver_options.SetParam("Tolerance", float(1.0e-12));
+    current_solver_options.SetParam("MaxIter", (unsigned int)200);
+    return std::make_shared<hephaestus::DivFreeSource>(
+        "source", "source", "HCurl", "H1", "_source_potential", current_solver_options);
+  }
+
+  static std::shared_ptr<mfem::ParMesh> MakeMesh()
+  {
+    mfem::Mesh mesh = mfem::Mesh::MakeCartesian3D(4, 4, 4, mfem::Element::HEXAHEDRON);
+    return std::make_shared<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+  }
+
+  // Vector potential after num_steps time steps of the A form
+  mfem::Vector SolveHCurl(bool use_lor, int num_steps)
+  {
+    hephaestus::Coefficients coefficients;
+    coefficients._scalars.Register("electrical_conductivity",
+                                   std::make_shared<mfem::ConstantCoefficient>(1.0));
+    coefficients._scalars.Register("magnetic_permeability",
+                                   std::make_shared<mfem::ConstantCoefficient>(1.0));
+
+    hephaestus::BCMap bc_map;
+    auto adot_vec_coef = std::make_shared<mfem::VectorFunctionCoefficient>(3, AdotBC);
+    coefficients._vectors.Register("surface_tangential_dAdt", adot_vec_coef);
+    bc_map.Register("tangential_dAdt",
+                    std::make_shared<hephaestus::VectorDirichletBC>(
+                        std::string("dmagnetic_vector_potential_dt"),
+                        mfem::Array<int>({1, 2, 3, 4, 5, 6}),
+                        adot_vec_coef.get()));
+
+    hephaestus::Sources sources;
+    sources.Register("source", MakeSource(coefficients));
+
+    auto problem_builder = std::make_unique<hephaestus::AFormulation>("magnetic_reluctivity",
+                                                                      "magnetic_permeability",
+                                                                      "electrical_conductivity",
+                                                                      "magnetic_vector_potential");
+    problem_builder->SetMesh(MakeMesh());
+    problem_builder->AddFESpace(std::string("HCurl"), std::string("ND_3D_P2"));
+    problem_builder->AddFESpace(std::string("H1"), std::string("H1_3D_P2"));
+    problem_builder->AddGridFunction("magnetic_vector_potential", "HCurl");
+    problem_builder->SetBoundaryConditions(bc_map);
+    problem_builder->SetCoefficients(coefficients);
+    problem_builder->SetSources(sources);
+    problem_builder->SetSolverOptions(SolverOptions(use_lor));
+
+    hephaestus::ProblemBuildSequencer sequencer(problem_builder.get());
+    sequencer.ConstructEquationSystemProblem();
+    std::unique_ptr<hephaestus::TimeDomainProblem> problem = problem_builder->ReturnProblem();
+
+    hephaestus::InputParameters exec_params;
+    exec_params.SetParam("TimeStep", float(0.05));
+    exec_params.SetParam("StartTime", float(0.00));
+    exec_params.SetParam("EndTime", float(0.05 * num_steps));
+    exec_params.SetParam("Problem", problem.get());
+    auto executioner = std::make_unique<hephaestus::TransientExecutioner>(exec_params);
+
+    for (int step = 0; step < num_steps; ++step)
+    {
+      executioner->Solve();
+    }
+    return problem->_gridfunctions.GetRef("magnetic_vector_potential");
+  }
+
+  // Magnetic flux density of the magnetostatic problem. The vector potential
+  // is only determined up to a gradient, so B = ∇×A is compared instead.
+  mfem::Vector SolveStatics(bool use_lor)
+  {
+    hephaestus::Coefficients coefficients;
+    coefficients._scalars.Register("magnetic_permeability",
+                                   std::make_shared<mfem::ConstantCoefficient>(1.0));
+
+    hephaestus::BCMap bc_map;
+    auto a_vec_coef = std::make_shared<mfem::VectorFunctionCoefficient>(3, ABC);
+    coefficients._vectors.Register("surface_tangential_A", a_vec_coef);
+    bc_map.Register("tangential_A",
+                    std::make_shared<hephaestus::VectorDirichletBC>(
+                        std::string("magnetic_vector_potential"),
+                        mfem::Array<int>({1, 2, 3, 4, 5, 6}),
+                        a_vec_coef.get()));
+
+    hephaestus::Sources sources;
+    sources.Register("source", MakeSource(coefficients));
+
+    auto problem_builder =
+        std::make_unique<hephaestus::MagnetostaticFormulation>("magnetic_reluctivity",
+                                                               "magnetic_permeability",
+                                                               "magnetic_vector_potential");
+    problem_builder->SetMesh(MakeMesh());
+    problem_builder->AddFESpace(std::string("HCurl"), std::string("ND_3D_P2"));
+    problem_builder->AddFESpace(std::string("H1"), std::string("H1_3D_P2"));
+    problem_builder->AddFESpace(std::string("HDiv"), std::string("RT_3D_P1"));
+    problem_builder->AddGridFunction("magnetic_vector_potential", "HCurl");
+    problem_builder->AddGridFunction("magnetic_flux_density", "HDiv");
+    problem_builder->RegisterMagneticFluxDensityAux("magnetic_flux_density");
+    problem_builder->SetBoundaryConditions(bc_map);
+    problem_builder->SetCoefficients(coefficients);
+    problem_builder->SetSources(sources);
+    problem_builder->SetSolverOptions(SolverOptions(use_lor));
+
+    hephaestus::ProblemBuildSequencer sequencer(problem_builder.get());
+    sequencer.ConstructOperatorProblem();
+    std::unique_ptr<hephaestus::SteadyStateProblem> problem = problem_builder->ReturnProblem();
+
+    hephaestus::InputParameters exec_params;
+    exec_params.SetParam("Problem", problem.get());
+    auto executioner = std::make_unique<hephaestus::SteadyExecutioner>(exec_params);
+    executioner->Execute();
+
+    return problem->_gridfunctions.GetRef("magnetic_flux_density");
+  }
+
+  static double RelativeDifference(const mfem::Vector & x, const mfem::Vector & reference)
+  {
+    mfem::Vector difference(x);
+    difference -= reference;
+    return mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) /
+           mfem::ParNormlp(reference, 2, MPI_COMM_WORLD);
+  }
+};
+
+TEST_CASE_METHOD(TestLORPreconditioner, "TestLORPreconditionerHCurl", "[CheckRun]")
+{
+  const int num_steps = 3;
+  const mfem::Vector reference = SolveHCurl(false, num_steps);
+  REQUIRE(mfem::ParNormlp(reference, 2, MPI_COMM_WORLD) > 0.0);
+
+  // Preconditioning on the LOR discretisation converges to the same solution
+  REQUIRE_THAT(RelativeDifference(SolveHCurl(true, num_steps), reference),
+               Catch::Matchers::WithinAbs(0.0, 1.0e-8));
+}
+
+TEST_CASE_METHOD(TestLORPreconditioner, "TestLORPreconditionerStatics", "[CheckRun]")
+{
+  const mfem::Vector reference = SolveStatics(false);
+  REQUIRE(mfem::ParNormlp(reference, 2, MPI_COMM_WORLD) > 0.0);
+
+  REQUIRE_THAT(RelativeDifference(SolveStatics(true), reference),
+               Catch::Matchers::WithinAbs(0.0, 1.0e-8));
+}
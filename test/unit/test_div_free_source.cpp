@@ -0,0 +1,154 @@
+#include "div_free_source.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+class TestDivFreeSource
+{
+protected:
+  // Spatial profile of the source, with a non-zero divergence
+  static void Profile(const mfem::Vector & x, mfem::Vector & v)
+  {
+    v.SetSize(3);
+    v(0) = x(0);
+    v(1) = x(1) * x(1);
+    v(2) = 0.0;
+  }
+
+  static double TimeFunction(double t) { return std::sin(2.0 * M_PI * t); }
+
+  // Separable source, f(t) J₀(x)
+  static void FullSource(const mfem::Vector & x, double t, mfem::Vector & v)
+  {
+    Profile(x, v);
+    v *= TimeFunction(t);
+  }
+
+  // Source supported on x < 0.5, with tangential components vanishing on its
+  // boundary
+  static void SubdomainSource(const mfem::Vector & x, mfem::Vector & v)
+  {
+    v.SetSize(3);
+    v = 0.0;
+    if (x(0) < 0.5)
+    {
+      v(0) = 1.0 + x(1);
+    }
+  }
+
+  void Setup()
+  {
+    // Elements with x < 0.5 form the support subdomain, with attribute 2
+    mfem::Mesh mesh = mfem::Mesh::MakeCartesian3D(4, 2, 2, mfem::Element::HEXAHEDRON);
+    mfem::Vector center;
+    for (int e = 0; e < mesh.GetNE(); ++e)
+    {
+      mesh.GetElementCenter(e, center);
+      mesh.SetAttribute(e, (center(0) < 0.5) ? 2 : 1);
+    }
+    mesh.SetAttributes();
+    _pmesh = std::make_shared<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+
+    _hcurl_fec = std::make_unique<mfem::ND_FECollection>(1, 3);
+    _h1_fec = std::make_unique<mfem::H1_FECollection>(1, 3);
+    _fespaces.Register("HCurl",
+                       std::make_shared<mfem::ParFiniteElementSpace>(_pmesh.get(),
+                                                                     _hcurl_fec.get()));
+    _fespaces.Register(
+        "H1", std::make_shared<mfem::ParFiniteElementSpace>(_pmesh.get(), _h1_fec.get()));
+
+    _coefficients._vectors.Register("profile",
+                                    std::make_shared<mfem::VectorFunctionCoefficient>(3, Profile));
+    _coefficients._vectors.Register(
+        "full_source", std::make_shared<mfem::VectorFunctionCoefficient>(3, FullSource));
+    _coefficients._vectors.Register(
+        "subdomain_source", std::make_shared<mfem::VectorFunctionCoefficient>(3, SubdomainSource));
+  }
+
+  std::unique_ptr<hephaestus::DivFreeSource> MakeSource(const std::string & coef_name)
+  {
+    hephaestus::InputParameters solver_options;
+    solver_options.SetParam("Tolerance", float(1.0e-12));
+    solver_options.SetParam("AbsTolerance", float(1.0e-20));
+    solver_options.SetParam("PrintLevel", -1);
+    return std::make_unique<hephaestus::DivFreeSource>(
+        coef_name, "source", "HCurl", "H1", "_source_potential", solver_options);
+  }
+
+  void Init(hephaestus::DivFreeSource & source, hephaestus::GridFunctions & gridfunctions)
+  {
+    source.Init(gridfunctions, _fespaces, _bc_map, _coefficients);
+  }
+
+  // Contribution of the source to an H(curl) linear form
+  mfem::Vector Apply(hephaestus::DivFreeSource & source)
+  {
+    mfem::ParLinearForm lf(_fespaces.Get("HCurl"));
+    lf = 0.0;
+    source.Apply(&lf);
+    return lf;
+  }
+
+  static double RelativeDifference(const mfem::Vector & x, const mfem::Vector & reference)
+  {
+    mfem::Vector difference(x);
+    difference -= reference;
+    return mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) /
+           mfem::ParNormlp(reference, 2, MPI_COMM_WORLD);
+  }
+
+  std::shared_ptr<mfem::ParMesh> _pmesh;
+  std::unique_ptr<mfem::FiniteElementCollection> _hcurl_fec, _h1_fec;
+  hephaestus::FESpaces _fespaces;
+  hephaestus::Coefficients _coefficients;
+  hephaestus::BCMap _bc_map;
+};
+
+TEST_CASE_METHOD(TestDivFreeSource, "DivFreeSourceSeparableTest", "[CheckData]")
+{
+  Setup();
+
+  // Each source registers its own grid functions
+  hephaestus::GridFunctions separable_gridfunctions, full_gridfunctions;
+  auto separable_source = MakeSource("profile");
+  separable_source->SetSeparableTimeFunction(TimeFunction);
+  Init(*separable_source, separable_gridfunctions);
+  auto full_source = MakeSource("full_source");
+  Init(*full_source, full_gridfunctions);
+
+  for (double t : {0.1, 0.3})
+  {
+    _coefficients.SetTime(t);
+    const mfem::Vector separable = Apply(*separable_source);
+    const mfem::Vector full = Apply(*full_source);
+    REQUIRE_THAT(RelativeDifference(separable, full), Catch::Matchers::WithinAbs(0.0, 1.0e-8));
+
+    // The divergence-free source fields also agree
+    REQUIRE_THAT(RelativeDifference(separable_gridfunctions.GetRef("source"),
+                                    full_gridfunctions.GetRef("source")),
+                 Catch::Matchers::WithinAbs(0.0, 1.0e-8));
+  }
+}
+
+TEST_CASE_METHOD(TestDivFreeSource, "DivFreeSourceSupportTest", "[CheckData]")
+{
+  Setup();
+
+  hephaestus::GridFunctions restricted_gridfunctions, unrestricted_gridfunctions;
+  auto restricted_source = MakeSource("subdomain_source");
+  mfem::Array<int> support_attributes;
+  support_attributes.Append(2);
+  restricted_source->SetSupport(support_attributes);
+  Init(*restricted_source, restricted_gridfunctions);
+  auto unrestricted_source = MakeSource("subdomain_source");
+  Init(*unrestricted_source, unrestricted_gridfunctions);
+
+  // The source lies in H(curl), so its projection is zero outside the support
+  // either way
+  const mfem::Vector restricted = Apply(*restricted_source);
+  const mfem::Vector unrestricted = Apply(*unrestricted_source);
+  REQUIRE_THAT(RelativeDifference(restricted, unrestricted),
+               Catch::Matchers::WithinAbs(0.0, 1.0e-8));
+  REQUIRE_THAT(RelativeDifference(restricted_gridfunctions.GetRef("_user_source"),
+                                  unrestricted_gridfunctions.GetRef("_user_source")),
+               Catch::Matchers::WithinAbs(0.0, 1.0e-8));
+}
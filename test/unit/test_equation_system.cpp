@@ -0,0 +1,409 @@
+#include "boundary_conditions.hpp"
+#include "equation_system.hpp"
+#include "kernels.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// Exposes the block structure of the equation system to the tests.
+class TestEquationSystem : public hephaestus::EquationSystem
+{
+public:
+  using hephaestus::EquationSystem::EquationSystem;
+  using hephaestus::EquationSystem::CanReuseJacobianStructure;
+
+  mfem::HypreParMatrix & GetBlock(int i, int j) { return *_h_blocks(i, j); }
+};
+
+// Entries of the local rows of a HypreParMatrix, keyed by global column
+static std::vector<std::map<HYPRE_BigInt, double>>
+LocalRows(mfem::HypreParMatrix & matrix)
+{
+  matrix.HostRead();
+  mfem::SparseMatrix diag, offd;
+  HYPRE_BigInt * cmap;
+  matrix.GetDiag(diag);
+  matrix.GetOffd(offd, cmap);
+  const HYPRE_BigInt first_col = matrix.ColPart()[0];
+
+  std::vector<std::map<HYPRE_BigInt, double>> rows(matrix.Height());
+  for (int row = 0; row < matrix.Height(); row++)
+  {
+    for (int k = diag.GetI()[row]; k < diag.GetI()[row + 1]; k++)
+    {
+      rows[row][first_col + diag.GetJ()[k]] += diag.GetData()[k];
+    }
+    for (int k = offd.GetI()[row]; k < offd.GetI()[row + 1]; k++)
+    {
+      rows[row][cmap[offd.GetJ()[k]]] += offd.GetData()[k];
+    }
+  }
+  return rows;
+}
+
+// Largest difference between corresponding entries of two matrices, over all
+// ranks. Entries missing from one of the matrices are taken to be zero.
+static double
+MaxEntryDifference(mfem::HypreParMatrix & a, mfem::HypreParMatrix & b)
+{
+  REQUIRE(a.Height() == b.Height());
+  const auto a_rows = LocalRows(a);
+  const auto b_rows = LocalRows(b);
+
+  double max_difference = 0.0;
+  for (int row = 0; row < a.Height(); row++)
+  {
+    for (const auto & [col, value] : a_rows[row])
+    {
+      auto it = b_rows[row].find(col);
+      const double other = (it != b_rows[row].end()) ? it->second : 0.0;
+      max_difference = std::max(max_difference, std::abs(value - other));
+    }
+    for (const auto & [col, value] : b_rows[row])
+    {
+      if (a_rows[row].find(col) == a_rows[row].end())
+      {
+        max_difference = std::max(max_difference, std::abs(value));
+      }
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &max_difference, 1, MPI_DOUBLE, MPI_MAX, a.GetComm());
+  return max_difference;
+}
+
+class TestAVEquationSystem
+{
+protected:
+  // Spaces, coefficients and boundary conditions of an A-V type system, with
+  // an H(curl) vector potential a and an H1 scalar potential v
+  void Setup()
+  {
+    mfem::Mesh mesh = mfem::Mesh::MakeCartesian3D(2, 2, 2, mfem::Element::HEXAHEDRON);
+    _pmesh = std::make_shared<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+
+    _hcurl_fec = std::make_unique<mfem::ND_FECollection>(1, 3);
+    _h1_fec = std::make_unique<mfem::H1_FECollection>(1, 3);
+    _fespaces.Register("HCurl",
+                       std::make_shared<mfem::ParFiniteElementSpace>(_pmesh.get(),
+                                                                     _hcurl_fec.get()));
+    _fespaces.Register(
+        "H1", std::make_shared<mfem::ParFiniteElementSpace>(_pmesh.get(), _h1_fec.get()));
+    _gridfunctions.Register("a", std::make_shared<mfem::ParGridFunction>(_fespaces.Get("HCurl")));
+    _gridfunctions.Register("v", std::make_shared<mfem::ParGridFunction>(_fespaces.Get("H1")));
+
+    _sigma = std::make_shared<mfem::ConstantCoefficient>(1.0);
+    _coefficients._scalars.Register("sigma", _sigma);
+    _coefficients._scalars.Register("v_bc", std::make_shared<mfem::ConstantCoefficient>(1.0));
+    mfem::Vector a_bc(3);
+    a_bc = 0.0;
+    a_bc(0) = 1.0;
+    _coefficients._vectors.Register("a_bc",
+                                    std::make_shared<mfem::VectorConstantCoefficient>(a_bc));
+
+    mfem::Array<int> bdr_attr;
+    bdr_attr.Append(1);
+    _bc_map.Register("a_bc",
+                     std::make_shared<hephaestus::VectorDirichletBC>(
+                         std::string("a"), bdr_attr, _coefficients._vectors.Get("a_bc")));
+    _bc_map.Register("v_bc",
+                     std::make_shared<hephaestus::ScalarDirichletBC>(
+                         std::string("v"), bdr_attr, _coefficients._scalars.Get("v_bc")));
+
+    _true_offsets.SetSize(3);
+    _true_offsets[0] = 0;
+    _true_offsets[1] = _fespaces.Get("HCurl")->GetTrueVSize();
+    _true_offsets[2] = _fespaces.Get("H1")->GetTrueVSize();
+    _true_offsets.PartialSum();
+  }
+
+  // Equation system coupling a and v through the mixed gradient block and
+  // either an assembled weak divergence block or its transpose
+  std::unique_ptr<TestEquationSystem> MakeEquationSystem(bool transpose_weak_divergence,
+                                                         bool monolithic = true)
+  {
+    hephaestus::InputParameters kernel_params;
+    kernel_params.SetParam("CoefficientName", std::string("sigma"));
+    hephaestus::InputParameters params;
+    params.SetParam("Monolithic", monolithic);
+    auto equation_system = std::make_unique<TestEquationSystem>(params);
+    equation_system->AddTrialVariableNameIfMissing("a");
+    equation_system->AddTrialVariableNameIfMissing("v");
+    equation_system->AddKernel("a", std::make_shared<hephaestus::CurlCurlKernel>(kernel_params));
+    equation_system->AddKernel("a",
+                               std::make_shared<hephaestus::VectorFEMassKernel>(kernel_params));
+    equation_system->AddKernel(
+        "v", "a", std::make_shared<hephaestus::MixedVectorGradientKernel>(kernel_params));
+    if (transpose_weak_divergence)
+    {
+      equation_system->AddTransposedBlock("a", "v", -1.0);
+    }
+    else
+    {
+      equation_system->AddKernel(
+          "a", "v", std::make_shared<hephaestus::VectorFEWeakDivergenceKernel>(kernel_params));
+    }
+    equation_system->AddKernel("v", std::make_shared<hephaestus::DiffusionKernel>(kernel_params));
+    equation_system->Init(_gridfunctions, _fespaces, _bc_map, _coefficients);
+    return equation_system;
+  }
+
+  void FormLinearSystem(TestEquationSystem & equation_system,
+                        mfem::OperatorHandle & op,
+                        mfem::BlockVector & true_rhs)
+  {
+    mfem::BlockVector true_x(_true_offsets);
+    equation_system.BuildEquationSystem(_bc_map, _sources);
+    equation_system.FormLinearSystem(op, true_x, true_rhs);
+  }
+
+  void FormLinearSystem(mfem::OperatorHandle & op)
+  {
+    mfem::BlockVector true_rhs(_true_offsets);
+    FormLinearSystem(*_equation_system, op, true_rhs);
+  }
+
+  // Largest difference from the monolithic matrix of an equation system
+  // built from scratch with the current coefficients and boundary conditions
+  double DifferenceFromScratch(mfem::OperatorHandle & op)
+  {
+    auto reference_system = MakeEquationSystem(false);
+    mfem::OperatorHandle reference_op;
+    mfem::BlockVector reference_rhs(_true_offsets);
+    FormLinearSystem(*reference_system, reference_op, reference_rhs);
+    return MaxEntryDifference(*op.As<mfem::HypreParMatrix>(),
+                              *reference_op.As<mfem::HypreParMatrix>());
+  }
+
+  // Informs the solver of changes to the Jacobian reported by the sequence
+  // counters of the equation system, as TimeDomainProblemOperator does
+  void SetJacobian(hephaestus::ReusableJacobianSolver & solver, mfem::OperatorHandle & op)
+  {
+    if (_equation_system->GetJacobianStructureSequence() != _structure_sequence)
+    {
+      solver.MarkStructureChanged();
+      _structure_sequence = _equation_system->GetJacobianStructureSequence();
+    }
+    if (_equation_system->GetJacobianValuesSequence() != _values_sequence)
+    {
+      solver.MarkOperatorChanged();
+      _values_sequence = _equation_system->GetJacobianValuesSequence();
+    }
+    solver.SetOperator(*op);
+  }
+
+  // Adds boundary conditions on v, changing its essential DoFs
+  void AddPotentialBC()
+  {
+    mfem::Array<int> bdr_attr;
+    bdr_attr.Append(2);
+    _bc_map.Register("v_bc_2",
+                     std::make_shared<hephaestus::ScalarDirichletBC>(
+                         std::string("v"), bdr_attr, _coefficients._scalars.Get("v_bc")));
+  }
+
+  std::shared_ptr<mfem::ParMesh> _pmesh;
+  std::unique_ptr<mfem::FiniteElementCollection> _hcurl_fec, _h1_fec;
+  hephaestus::FESpaces _fespaces;
+  hephaestus::GridFunctions _gridfunctions;
+  hephaestus::Coefficients _coefficients;
+  hephaestus::BCMap _bc_map;
+  hephaestus::Sources _sources;
+  std::shared_ptr<mfem::ConstantCoefficient> _sigma;
+  std::unique_ptr<TestEquationSystem> _equation_system;
+  mfem::Array<int> _true_offsets;
+  long _values_sequence{-1};
+  long _structure_sequence{-1};
+};
+
+TEST_CASE_METHOD(TestAVEquationSystem, "MonolithicUpdateTest", "[CheckData]")
+{
+  Setup();
+  _equation_system = MakeEquationSystem(false);
+
+  mfem::OperatorHandle op;
+  FormLinearSystem(op);
+  auto * monolithic = op.As<mfem::HypreParMatrix>();
+  REQUIRE(monolithic != nullptr);
+  REQUIRE(_equation_system->CanReuseJacobianStructure(op));
+  mfem::HypreParMatrix initial(*monolithic);
+  const long structure_sequence = _equation_system->GetJacobianStructureSequence();
+
+  SECTION("Values-only change overwrites the existing matrix")
+  {
+    _sigma->constant = 3.0;
+    _coefficients.MarkChanged("sigma");
+    FormLinearSystem(op);
+
+    REQUIRE(op.As<mfem::HypreParMatrix>() == monolithic);
+    REQUIRE(_equation_system->GetJacobianStructureSequence() == structure_sequence);
+
+    REQUIRE_THAT(DifferenceFromScratch(op), Catch::Matchers::WithinAbs(0.0, 1.0e-12));
+
+    // The values have changed
+    REQUIRE(MaxEntryDifference(*monolithic, initial) > 1.0e-3);
+  }
+
+  SECTION("Change of essential DoFs rebuilds the matrix")
+  {
+    // Only the boundary conditions change; the forms must be eliminated anew
+    AddPotentialBC();
+
+    // Essential DoFs are recomputed when the linear forms are rebuilt
+    _equation_system->BuildEquationSystem(_bc_map, _sources);
+    REQUIRE_FALSE(_equation_system->CanReuseJacobianStructure(op));
+
+    FormLinearSystem(op);
+    REQUIRE(_equation_system->GetJacobianStructureSequence() == structure_sequence + 1);
+    REQUIRE(_equation_system->CanReuseJacobianStructure(op));
+
+    REQUIRE_THAT(DifferenceFromScratch(op), Catch::Matchers::WithinAbs(0.0, 1.0e-12));
+    REQUIRE(MaxEntryDifference(*op.As<mfem::HypreParMatrix>(), initial) > 1.0e-3);
+  }
+}
+
+TEST_CASE_METHOD(TestAVEquationSystem, "TransposedBlockTest", "[CheckData]")
+{
+  Setup();
+  auto assembled = MakeEquationSystem(false);
+  auto transposed = MakeEquationSystem(true);
+
+  mfem::OperatorHandle assembled_op, transposed_op;
+  mfem::BlockVector assembled_rhs(_true_offsets), transposed_rhs(_true_offsets);
+  FormLinearSystem(*assembled, assembled_op, assembled_rhs);
+  FormLinearSystem(*transposed, transposed_op, transposed_rhs);
+
+  // -(σ a, ∇ v') block, with the essential DoFs of both variables eliminated
+  REQUIRE_THAT(MaxEntryDifference(assembled->GetBlock(1, 0), transposed->GetBlock(1, 0)),
+               Catch::Matchers::WithinAbs(0.0, 1.0e-12));
+
+  // Contribution of the essential values of a to the right hand side of v
+  mfem::Vector difference(assembled_rhs.GetBlock(1));
+  difference -= transposed_rhs.GetBlock(1);
+  const double rhs_norm = mfem::ParNormlp(assembled_rhs.GetBlock(1), 2, MPI_COMM_WORLD);
+  REQUIRE(rhs_norm > 0.0);
+  REQUIRE_THAT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) / rhs_norm,
+               Catch::Matchers::WithinAbs(0.0, 1.0e-12));
+}
+
+TEST_CASE_METHOD(TestAVEquationSystem, "ReusableJacobianSolverTest", "[CheckData]")
+{
+  using ReusePolicy = hephaestus::ReusableJacobianSolver::ReusePolicy;
+
+  Setup();
+  _equation_system = MakeEquationSystem(false);
+
+  // Number of setups expected after a change of values only, which is
+  // picked up by REBUILD_ON_CHANGE but left to the iteration count by
+  // ITERATION_THRESHOLD
+  ReusePolicy policy = ReusePolicy::ITERATION_THRESHOLD;
+  int setups_after_values_change = 1;
+  SECTION("Iteration threshold")
+  {
+    policy = ReusePolicy::ITERATION_THRESHOLD;
+    setups_after_values_change = 1;
+  }
+  SECTION("Rebuild on change")
+  {
+    policy = ReusePolicy::REBUILD_ON_CHANGE;
+    setups_after_values_change = 2;
+  }
+  hephaestus::ReusableJacobianSolver solver(std::make_shared<mfem::CGSolver>(MPI_COMM_WORLD),
+                                            policy);
+
+  mfem::OperatorHandle op;
+  FormLinearSystem(op);
+  SetJacobian(solver, op);
+  REQUIRE(solver.GetNumSetups() == 1);
+
+  // Unchanged Jacobian
+  const long initial_values_sequence = _values_sequence;
+  FormLinearSystem(op);
+  REQUIRE(_equation_system->GetJacobianValuesSequence() == initial_values_sequence);
+  SetJacobian(solver, op);
+  REQUIRE(solver.GetNumSetups() == 1);
+
+  // Values-only change
+  const long initial_structure_sequence = _structure_sequence;
+  _sigma->constant = 3.0;
+  _coefficients.MarkChanged("sigma");
+  FormLinearSystem(op);
+  REQUIRE(_equation_system->GetJacobianValuesSequence() > initial_values_sequence);
+  REQUIRE(_equation_system->GetJacobianStructureSequence() == initial_structure_sequence);
+  SetJacobian(solver, op);
+  REQUIRE(solver.GetNumSetups() == setups_after_values_change);
+
+  // Structure change
+  AddPotentialBC();
+  FormLinearSystem(op);
+  REQUIRE(_equation_system->GetJacobianStructureSequence() > initial_structure_sequence);
+  SetJacobian(solver, op);
+  REQUIRE(solver.GetNumSetups() == setups_after_values_change + 1);
+}
+
+TEST_CASE_METHOD(TestAVEquationSystem, "ReusableJacobianSolverBlockTest", "[CheckData]")
+{
+  using ReusePolicy = hephaestus::ReusableJacobianSolver::ReusePolicy;
+  using Structure = hephaestus::HCurlH1BlockPreconditioner::Structure;
+
+  Setup();
+  _equation_system = MakeEquationSystem(false, false);
+
+  // Block preconditioner, set up again only when the iteration count grows
+  hephaestus::ReusableJacobianSolver preconditioner(
+      std::make_shared<hephaestus::HCurlH1BlockPreconditioner>(
+          _fespaces.Get("HCurl"), Structure::LOWER_TRIANGULAR, -1),
+      ReusePolicy::ITERATION_THRESHOLD);
+
+  // Solves the current linear system with the preconditioner, and returns the
+  // relative residual
+  auto solve = [&](mfem::OperatorHandle & op, mfem::BlockVector & true_rhs)
+  {
+    mfem::GMRESSolver gmres(MPI_COMM_WORLD);
+    gmres.SetRelTol(1.0e-10);
+    gmres.SetAbsTol(0.0);
+    gmres.SetMaxIter(500);
+    gmres.SetKDim(100);
+    gmres.SetPrintLevel(-1);
+    gmres.SetOperator(*op);
+    gmres.SetPreconditioner(preconditioner);
+
+    mfem::Vector x(true_rhs.Size());
+    x = 0.0;
+    gmres.Mult(true_rhs, x);
+
+    mfem::Vector residual(true_rhs);
+    op->AddMult(x, residual, -1.0);
+    return mfem::ParNormlp(residual, 2, MPI_COMM_WORLD) /
+           mfem::ParNormlp(true_rhs, 2, MPI_COMM_WORLD);
+  };
+
+  mfem::OperatorHandle op;
+  mfem::BlockVector true_rhs(_true_offsets);
+  FormLinearSystem(*_equation_system, op, true_rhs);
+  auto * block_op = dynamic_cast<mfem::BlockOperator *>(op.Ptr());
+  REQUIRE(block_op != nullptr);
+  const mfem::Operator * curl_curl_block = &block_op->GetBlock(0, 0);
+  SetJacobian(preconditioner, op);
+  REQUIRE(preconditioner.GetNumSetups() == 1);
+  REQUIRE(solve(op, true_rhs) < 1.0e-8);
+
+  // Values-only change: the block operator and its blocks are updated in
+  // place, so the preconditioner set up with them remains valid
+  const long initial_structure_sequence = _structure_sequence;
+  _sigma->constant = 3.0;
+  _coefficients.MarkChanged("sigma");
+  FormLinearSystem(*_equation_system, op, true_rhs);
+  REQUIRE(op.Ptr() == block_op);
+  REQUIRE(&block_op->GetBlock(0, 0) == curl_curl_block);
+  REQUIRE(_equation_system->GetJacobianStructureSequence() == initial_structure_sequence);
+  SetJacobian(preconditioner, op);
+  REQUIRE(preconditioner.GetNumSetups() == 1);
+  REQUIRE(solve(op, true_rhs) < 1.0e-8);
+
+  // Structure change
+  AddPotentialBC();
+  FormLinearSystem(*_equation_system, op, true_rhs);
+  REQUIRE(_equation_system->GetJacobianStructureSequence() == initial_structure_sequence + 1);
+  SetJacobian(preconditioner, op);
+  REQUIRE(preconditioner.GetNumSetups() == 2);
+  REQUIRE(solve(op, true_rhs) < 1.0e-8);
+}
@@ -0,0 +1,93 @@
+#include "boundary_conditions.hpp"
+#include "helmholtz_projector.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+class TestHelmholtzProjector
+{
+protected:
+  // Field with a non-zero divergence
+  static void Source(const mfem::Vector & x, mfem::Vector & v)
+  {
+    v.SetSize(3);
+    v(0) = x(0);
+    v(1) = x(1) * x(1);
+    v(2) = 0.0;
+  }
+
+  void Setup()
+  {
+    mfem::Mesh mesh = mfem::Mesh::MakeCartesian3D(3, 3, 3, mfem::Element::HEXAHEDRON);
+    _pmesh = std::make_shared<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+
+    _hcurl_fec = std::make_unique<mfem::ND_FECollection>(1, 3);
+    _h1_fec = std::make_unique<mfem::H1_FECollection>(1, 3);
+    _fespaces.Register("HCurl",
+                       std::make_shared<mfem::ParFiniteElementSpace>(_pmesh.get(),
+                                                                     _hcurl_fec.get()));
+    _fespaces.Register(
+        "H1", std::make_shared<mfem::ParFiniteElementSpace>(_pmesh.get(), _h1_fec.get()));
+    _gridfunctions.Register("g", std::make_shared<mfem::ParGridFunction>(_fespaces.Get("HCurl")));
+    _gridfunctions.Register("q", std::make_shared<mfem::ParGridFunction>(_fespaces.Get("H1")));
+
+    _params.SetParam("VectorGridFunctionName", std::string("g"));
+    _params.SetParam("ScalarGridFunctionName", std::string("q"));
+    _params.SetParam("HCurlFESpaceName", std::string("HCurl"));
+    _params.SetParam("H1FESpaceName", std::string("H1"));
+  }
+
+  // Fix the potential on the given boundary attribute
+  void AddPotentialBC(int attribute)
+  {
+    mfem::Array<int> bdr_attr;
+    bdr_attr.Append(attribute);
+    _bc_map.Register("q_bc_" + std::to_string(attribute),
+                     std::make_shared<hephaestus::ScalarDirichletBC>(
+                         std::string("q"), bdr_attr, &_zero));
+  }
+
+  // Divergence-free projection of the source
+  mfem::Vector Project(hephaestus::HelmholtzProjector & projector)
+  {
+    mfem::VectorFunctionCoefficient source(3, Source);
+    auto & g = _gridfunctions.GetRef("g");
+    g.ProjectCoefficient(source);
+    projector.Project(_gridfunctions, _fespaces, _bc_map);
+    return g;
+  }
+
+  std::shared_ptr<mfem::ParMesh> _pmesh;
+  std::unique_ptr<mfem::FiniteElementCollection> _hcurl_fec, _h1_fec;
+  hephaestus::FESpaces _fespaces;
+  hephaestus::GridFunctions _gridfunctions;
+  hephaestus::BCMap _bc_map;
+  hephaestus::InputParameters _params;
+  mfem::ConstantCoefficient _zero{0.0};
+};
+
+TEST_CASE_METHOD(TestHelmholtzProjector, "HelmholtzProjectorEssentialDofsTest", "[CheckData]")
+{
+  Setup();
+
+  // Project with one set of essential DoFs, then another
+  hephaestus::HelmholtzProjector projector(_params);
+  AddPotentialBC(1);
+  const mfem::Vector first = Project(projector);
+  AddPotentialBC(2);
+  const mfem::Vector second = Project(projector);
+
+  // Same projection as a projector that has only seen the second set
+  hephaestus::HelmholtzProjector fresh_projector(_params);
+  const mfem::Vector reference = Project(fresh_projector);
+
+  mfem::Vector difference(second);
+  difference -= reference;
+  const double reference_norm = mfem::ParNormlp(reference, 2, MPI_COMM_WORLD);
+  REQUIRE_THAT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) / reference_norm,
+               Catch::Matchers::WithinAbs(0.0, 1.0e-8));
+
+  // The essential DoFs change the projection
+  difference = second;
+  difference -= first;
+  REQUIRE(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) / reference_norm > 1.0e-4);
+}
@@ -0,0 +1,174 @@
+#include "open_coil.hpp"
+#include "open_coil_group.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+extern const char * DATA_DIR;
+
+TEST_CASE("OpenCoilGroupTest", "[CheckData]")
+{
+
+  // Floating point error tolerance
+  const double eps{1e-10};
+
+  int order = 1;
+
+  mfem::Mesh mesh((std::string(DATA_DIR) + "coil.gen").c_str(), 1, 1);
+  auto pmesh = std::make_shared<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+
+  mfem::ND_FECollection h_curl_collection(order, pmesh.get()->Dimension());
+  auto h_curl_fe_space =
+      std::make_shared<mfem::ParFiniteElementSpace>(pmesh.get(), &h_curl_collection);
+  auto e = std::make_shared<mfem::ParGridFunction>(h_curl_fe_space.get());
+
+  mfem::H1_FECollection h1_collection(order, pmesh.get()->Dimension());
+  auto h1_fe_space = std::make_shared<mfem::ParFiniteElementSpace>(pmesh.get(), &h1_collection);
+  auto v = std::make_shared<mfem::ParGridFunction>(h1_fe_space.get());
+
+  const double ival = 10.0;
+  const double cond_val = 1e6;
+
+  auto itot = std::make_shared<mfem::ConstantCoefficient>(ival);
+  auto conductivity = std::make_shared<mfem::ConstantCoefficient>(cond_val);
+
+  hephaestus::BCMap bc_maps;
+
+  hephaestus::Coefficients coefficients;
+  coefficients._scalars.Register(std::string("Itotal"), itot);
+  coefficients._scalars.Register(std::string("Conductivity"), conductivity);
+
+  hephaestus::FESpaces fespaces;
+  fespaces.Register(std::string("HCurl"), h_curl_fe_space);
+  fespaces.Register(std::string("H1"), h1_fe_space);
+
+  hephaestus::GridFunctions gridfunctions;
+  gridfunctions.Register(std::string("E"), e);
+  gridfunctions.Register(std::string("V"), v);
+
+  std::pair<int, int> elec_attrs{1, 2};
+  mfem::Array<int> submesh_domains;
+  submesh_domains.Append(1);
+
+  hephaestus::OpenCoilGroupSolver opencoil_group(
+      "E", "V", "Conductivity", {{"Itotal", submesh_domains, elec_attrs}});
+  opencoil_group.Init(gridfunctions, fespaces, bc_maps, coefficients);
+  mfem::ParLinearForm dummy(h_curl_fe_space.get());
+  dummy = 0.0;
+  opencoil_group.Apply(&dummy);
+
+  //- sign comes from the direction of the outward facing normal relative to elec_attrs order
+  double flux = -hephaestus::calcFlux(e.get(), elec_attrs.first, *conductivity);
+
+  REQUIRE_THAT(flux, Catch::Matchers::WithinAbs(ival, eps));
+}
+
+TEST_CASE("OpenCoilGroupTwoCoilsTest", "[CheckData]")
+{
+
+  // Floating point error tolerance
+  const double eps{1e-10};
+
+  int order = 1;
+
+  // Bar along x with a coil at each end, separated by a gap. Each coil has its
+  // electrodes on its faces at y = 0 and y = 1.
+  mfem::Mesh mesh = mfem::Mesh::MakeCartesian3D(10, 2, 2, mfem::Element::HEXAHEDRON, 5.0);
+  mfem::Vector center;
+  for (int e = 0; e < mesh.GetNE(); ++e)
+  {
+    mesh.GetElementCenter(e, center);
+    mesh.SetAttribute(e, (center(0) < 1.0) ? 1 : (center(0) > 4.0) ? 2 : 3);
+  }
+  mfem::Array<int> vertices;
+  for (int b = 0; b < mesh.GetNBE(); ++b)
+  {
+    mesh.GetBdrElementVertices(b, vertices);
+    center.SetSize(3);
+    center = 0.0;
+    for (auto vertex : vertices)
+    {
+      center.Add(1.0 / vertices.Size(), mfem::Vector(mesh.GetVertex(vertex), 3));
+    }
+
+    const int coil = (center(0) < 1.0) ? 1 : (center(0) > 4.0) ? 2 : 0;
+    int attr = 100;
+    if (coil > 0 && center(1) < 1.0e-12)
+      attr = 10 * coil + 1;
+    else if (coil > 0 && center(1) > 1.0 - 1.0e-12)
+      attr = 10 * coil + 2;
+    mesh.SetBdrAttribute(b, attr);
+  }
+  mesh.SetAttributes();
+  auto pmesh = std::make_shared<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+
+  mfem::ND_FECollection h_curl_collection(order, pmesh.get()->Dimension());
+  auto h_curl_fe_space =
+      std::make_shared<mfem::ParFiniteElementSpace>(pmesh.get(), &h_curl_collection);
+  mfem::H1_FECollection h1_collection(order, pmesh.get()->Dimension());
+  auto h1_fe_space = std::make_shared<mfem::ParFiniteElementSpace>(pmesh.get(), &h1_collection);
+
+  const double cond_val = 1e6;
+  auto conductivity = std::make_shared<mfem::ConstantCoefficient>(cond_val);
+
+  hephaestus::BCMap bc_maps;
+
+  hephaestus::Coefficients coefficients;
+  const std::vector<std::string> currents{"I1", "I2"};
+  const std::vector<double> ivals{10.0, -4.0};
+  for (int k = 0; k < 2; ++k)
+    coefficients._scalars.Register(currents[k],
+                                   std::make_shared<mfem::ConstantCoefficient>(ivals[k]));
+  coefficients._scalars.Register(std::string("Conductivity"), conductivity);
+
+  hephaestus::FESpaces fespaces;
+  fespaces.Register(std::string("HCurl"), h_curl_fe_space);
+  fespaces.Register(std::string("H1"), h1_fe_space);
+
+  // Fields of a source, registered in their own set of grid functions
+  auto make_fields = [&](hephaestus::GridFunctions & gridfunctions)
+  {
+    auto e = std::make_shared<mfem::ParGridFunction>(h_curl_fe_space.get());
+    gridfunctions.Register(std::string("E"), e);
+    gridfunctions.Register(std::string("V"),
+                           std::make_shared<mfem::ParGridFunction>(h1_fe_space.get()));
+    return e;
+  };
+
+  const std::vector<std::pair<int, int>> elec_attrs{{11, 12}, {21, 22}};
+  std::vector<mfem::Array<int>> coil_domains(2);
+  coil_domains[0].Append(1);
+  coil_domains[1].Append(2);
+
+  hephaestus::GridFunctions group_gridfunctions;
+  auto e_group = make_fields(group_gridfunctions);
+  hephaestus::OpenCoilGroupSolver opencoil_group("E",
+                                                 "V",
+                                                 "Conductivity",
+                                                 {{currents[0], coil_domains[0], elec_attrs[0]},
+                                                  {currents[1], coil_domains[1], elec_attrs[1]}});
+  opencoil_group.Init(group_gridfunctions, fespaces, bc_maps, coefficients);
+  mfem::ParLinearForm group_lf(h_curl_fe_space.get());
+  group_lf = 0.0;
+  opencoil_group.Apply(&group_lf);
+
+  for (int k = 0; k < 2; ++k)
+  {
+    // Same coil as a standalone source
+    hephaestus::GridFunctions gridfunctions;
+    auto e = make_fields(gridfunctions);
+    hephaestus::OpenCoilSolver opencoil(
+        "E", "V", currents[k], "Conductivity", coil_domains[k], elec_attrs[k]);
+    opencoil.Init(gridfunctions, fespaces, bc_maps, coefficients);
+    mfem::ParLinearForm lf(h_curl_fe_space.get());
+    lf = 0.0;
+    opencoil.Apply(&lf);
+
+    //- sign comes from the direction of the outward facing normal relative to elec_attrs order
+    double flux = -hephaestus::calcFlux(e.get(), elec_attrs[k].first, *conductivity);
+    double group_flux =
+        -hephaestus::calcFlux(e_group.get(), elec_attrs[k].first, *conductivity);
+
+    REQUIRE_THAT(flux, Catch::Matchers::WithinAbs(ivals[k], eps));
+    REQUIRE_THAT(group_flux, Catch::Matchers::WithinAbs(flux, eps));
+  }
+}
@@ -0,0 +1,131 @@
+#include "curl_curl_kernel.hpp"
+#include "weak_curl_curl_kernel.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+class TestOperatorRegistry
+{
+protected:
+  static void Field(const mfem::Vector & x, mfem::Vector & v)
+  {
+    v.SetSize(3);
+    v(0) = x(1) * x(2);
+    v(1) = x(0) * x(0);
+    v(2) = x(0) + x(1);
+  }
+
+  void Setup()
+  {
+    mfem::Mesh mesh = mfem::Mesh::MakeCartesian3D(3, 3, 3, mfem::Element::HEXAHEDRON);
+    _pmesh = std::make_shared<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+
+    _hcurl_fec = std::make_unique<mfem::ND_FECollection>(1, 3);
+    _fespaces.Register("HCurl",
+                       std::make_shared<mfem::ParFiniteElementSpace>(_pmesh.get(),
+                                                                     _hcurl_fec.get()));
+    auto u = std::make_shared<mfem::ParGridFunction>(_fespaces.Get("HCurl"));
+    mfem::VectorFunctionCoefficient field(3, Field);
+    u->ProjectCoefficient(field);
+    _gridfunctions.Register("u", u);
+
+    _alpha = std::make_shared<mfem::ConstantCoefficient>(1.0);
+    _coefficients._scalars.Register("alpha", _alpha);
+
+    _params.SetParam("CoefficientName", std::string("alpha"));
+    _params.SetParam("CoupledVariableName", std::string("u"));
+  }
+
+  // Curl-curl kernels, sharing their form through registry if given
+  void MakeKernels(hephaestus::OperatorRegistry * registry,
+                   std::unique_ptr<hephaestus::CurlCurlKernel> & curl_curl,
+                   std::unique_ptr<hephaestus::WeakCurlCurlKernel> & weak_curl_curl)
+  {
+    curl_curl = std::make_unique<hephaestus::CurlCurlKernel>(_params);
+    weak_curl_curl = std::make_unique<hephaestus::WeakCurlCurlKernel>(_params);
+    if (registry != nullptr)
+    {
+      curl_curl->SetOperatorRegistry(registry);
+      weak_curl_curl->SetOperatorRegistry(registry);
+    }
+    curl_curl->Init(_gridfunctions, _fespaces, _bc_map, _coefficients);
+    weak_curl_curl->Init(_gridfunctions, _fespaces, _bc_map, _coefficients);
+  }
+
+  // Action of the system matrix built with the kernel on u, as the equation
+  // system builds it
+  mfem::Vector MatrixAction(hephaestus::CurlCurlKernel & kernel)
+  {
+    mfem::ParBilinearForm blf(_fespaces.Get("HCurl"));
+    kernel.Apply(&blf);
+    blf.Assemble();
+    kernel.ApplyAssembled(&blf);
+    blf.Finalize();
+
+    mfem::Vector action(blf.Height());
+    blf.SpMat().Mult(_gridfunctions.GetRef("u"), action);
+    return action;
+  }
+
+  mfem::Vector RHS(hephaestus::WeakCurlCurlKernel & kernel)
+  {
+    mfem::ParLinearForm lf(_fespaces.Get("HCurl"));
+    lf = 0.0;
+    kernel.Apply(&lf);
+    return lf;
+  }
+
+  static double RelativeDifference(const mfem::Vector & x, const mfem::Vector & reference)
+  {
+    mfem::Vector difference(x);
+    difference -= reference;
+    return mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) /
+           mfem::ParNormlp(reference, 2, MPI_COMM_WORLD);
+  }
+
+  std::shared_ptr<mfem::ParMesh> _pmesh;
+  std::unique_ptr<mfem::FiniteElementCollection> _hcurl_fec;
+  hephaestus::FESpaces _fespaces;
+  hephaestus::GridFunctions _gridfunctions;
+  hephaestus::Coefficients _coefficients;
+  hephaestus::BCMap _bc_map;
+  hephaestus::InputParameters _params;
+  std::shared_ptr<mfem::ConstantCoefficient> _alpha;
+};
+
+TEST_CASE_METHOD(TestOperatorRegistry, "OperatorRegistrySharedCurlCurlTest", "[CheckData]")
+{
+  Setup();
+
+  hephaestus::OperatorRegistry registry;
+  std::unique_ptr<hephaestus::CurlCurlKernel> curl_curl;
+  std::unique_ptr<hephaestus::WeakCurlCurlKernel> weak_curl_curl;
+  MakeKernels(&registry, curl_curl, weak_curl_curl);
+
+  for (double alpha : {1.0, 2.5})
+  {
+    if (alpha != _alpha->constant)
+    {
+      _alpha->constant = alpha;
+      _coefficients.MarkChanged("alpha");
+      REQUIRE(curl_curl->IsDirty());
+    }
+    const long num_assemblies = registry.GetNumAssemblies();
+
+    // The form is assembled once for both kernels
+    const mfem::Vector action = MatrixAction(*curl_curl);
+    const mfem::Vector rhs = RHS(*weak_curl_curl);
+    REQUIRE(registry.GetNumAssemblies() == num_assemblies + 1);
+    curl_curl->MarkClean();
+    weak_curl_curl->MarkClean();
+
+    // Same system matrix and right hand side as kernels set up without the
+    // registry with the current coefficient
+    std::unique_ptr<hephaestus::CurlCurlKernel> unshared_curl_curl;
+    std::unique_ptr<hephaestus::WeakCurlCurlKernel> unshared_weak_curl_curl;
+    MakeKernels(nullptr, unshared_curl_curl, unshared_weak_curl_curl);
+    REQUIRE_THAT(RelativeDifference(action, MatrixAction(*unshared_curl_curl)),
+                 Catch::Matchers::WithinAbs(0.0, 1.0e-12));
+    REQUIRE_THAT(RelativeDifference(rhs, RHS(*unshared_weak_curl_curl)),
+                 Catch::Matchers::WithinAbs(0.0, 1.0e-12));
+  }
+}
@@ -0,0 +1,83 @@
+#include "hephaestus_solvers.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+TEST_CASE("RecyclingPCGSolverTest", "[CheckData]")
+{
+  const double tolerance = 1.0e-10;
+
+  // Diffusion system on the unit cube, with homogeneous Dirichlet boundaries
+  mfem::Mesh mesh = mfem::Mesh::MakeCartesian3D(6, 6, 6, mfem::Element::HEXAHEDRON);
+  mfem::ParMesh pmesh(MPI_COMM_WORLD, mesh);
+  mfem::H1_FECollection h1_collection(1, pmesh.Dimension());
+  mfem::ParFiniteElementSpace h1_fe_space(&pmesh, &h1_collection);
+
+  mfem::Array<int> ess_bdr(pmesh.bdr_attributes.Max());
+  ess_bdr = 1;
+  mfem::Array<int> ess_tdofs;
+  h1_fe_space.GetEssentialTrueDofs(ess_bdr, ess_tdofs);
+
+  mfem::ParBilinearForm diffusion(&h1_fe_space);
+  diffusion.AddDomainIntegrator(new mfem::DiffusionIntegrator);
+  diffusion.Assemble();
+  diffusion.Finalize();
+  mfem::HypreParMatrix a;
+  diffusion.FormSystemMatrix(ess_tdofs, a);
+
+  // A sequence of nearby right-hand sides
+  const int n = a.Height();
+  auto rhs = [&](int k)
+  {
+    mfem::Vector b(n);
+    for (int i = 0; i < n; i++)
+    {
+      b(i) = 1.0 + 0.01 * k * std::sin(i + 1.0);
+    }
+    b.SetSubVector(ess_tdofs, 0.0);
+    return b;
+  };
+
+  // Unpreconditioned, so that the slow modes left to deflation are pronounced
+  hephaestus::RecyclingPCGSolver recycling_pcg(MPI_COMM_WORLD, 5, 20);
+  recycling_pcg.SetOperator(a);
+  recycling_pcg.SetRelTol(tolerance);
+  recycling_pcg.SetAbsTol(0.0);
+  recycling_pcg.SetMaxIter(1000);
+  recycling_pcg.SetPrintLevel(0);
+
+  mfem::HyprePCG hypre_pcg(a);
+  hypre_pcg.SetTol(tolerance);
+  hypre_pcg.SetMaxIter(1000);
+  hypre_pcg.SetPrintLevel(0);
+
+  std::vector<int> iterations;
+  for (int k = 0; k < 4; k++)
+  {
+    const mfem::Vector b = rhs(k);
+
+    mfem::Vector x(n);
+    x = 0.0;
+    recycling_pcg.Mult(b, x);
+    REQUIRE(recycling_pcg.GetConverged());
+    iterations.push_back(recycling_pcg.GetNumIterations());
+
+    // Same solution as HyprePCG
+    mfem::Vector x_ref(n);
+    x_ref = 0.0;
+    hypre_pcg.Mult(b, x_ref);
+
+    mfem::Vector difference(x);
+    difference -= x_ref;
+    const double relative_difference = mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) /
+                                       mfem::ParNormlp(x_ref, 2, MPI_COMM_WORLD);
+    REQUIRE_THAT(relative_difference, Catch::Matchers::WithinAbs(0.0, 1.0e-6));
+  }
+
+  // Recycling reduces the iteration count of the later solves
+  REQUIRE(iterations.back() < iterations.front());
+  for (std::size_t k = 1; k < iterations.size(); k++)
+  {
+    REQUIRE(iterations.at(k) <= iterations.front());
+  }
+  REQUIRE(recycling_pcg.GetIterationsSaved() > 0);
+}
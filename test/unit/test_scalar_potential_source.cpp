@@ -0,0 +1,98 @@
+#include "boundary_conditions.hpp"
+#include "scalar_potential_source.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+class TestScalarPotentialSource
+{
+protected:
+  void Setup()
+  {
+    mfem::Mesh mesh = mfem::Mesh::MakeCartesian3D(3, 3, 3, mfem::Element::HEXAHEDRON);
+    _pmesh = std::make_shared<mfem::ParMesh>(MPI_COMM_WORLD, mesh);
+
+    _hcurl_fec = std::make_unique<mfem::ND_FECollection>(1, 3);
+    _h1_fec = std::make_unique<mfem::H1_FECollection>(1, 3);
+    _fespaces.Register("HCurl",
+                       std::make_shared<mfem::ParFiniteElementSpace>(_pmesh.get(),
+                                                                     _hcurl_fec.get()));
+    _fespaces.Register(
+        "H1", std::make_shared<mfem::ParFiniteElementSpace>(_pmesh.get(), _h1_fec.get()));
+
+    // Conductivity varying across the domain, so that the potential depends on it
+    _coefficients._scalars.Register(
+        "conductivity",
+        std::make_shared<mfem::FunctionCoefficient>([this](const mfem::Vector & x)
+                                                    { return 1.0 + _slope * x(0); }));
+
+    // Potential difference between two opposite faces
+    mfem::Array<int> high_attr, ground_attr;
+    high_attr.Append(3);
+    ground_attr.Append(5);
+    _bc_map.Register("high",
+                     std::make_shared<hephaestus::ScalarDirichletBC>(
+                         std::string("phi"), high_attr, &_one));
+    _bc_map.Register("ground",
+                     std::make_shared<hephaestus::ScalarDirichletBC>(
+                         std::string("phi"), ground_attr, &_zero));
+  }
+
+  std::unique_ptr<hephaestus::ScalarPotentialSource> MakeSource()
+  {
+    hephaestus::InputParameters solver_options;
+    solver_options.SetParam("Tolerance", float(1.0e-12));
+    solver_options.SetParam("AbsTolerance", float(1.0e-20));
+    solver_options.SetParam("PrintLevel", -1);
+    auto source = std::make_unique<hephaestus::ScalarPotentialSource>(
+        "grad_phi", "phi", "HCurl", "H1", "conductivity", -1, solver_options);
+    source->Init(_gridfunctions, _fespaces, _bc_map, _coefficients);
+    return source;
+  }
+
+  // Contribution of the source to an H(curl) linear form
+  mfem::Vector Apply(hephaestus::ScalarPotentialSource & source)
+  {
+    mfem::ParLinearForm lf(_fespaces.Get("HCurl"));
+    lf = 0.0;
+    source.Apply(&lf);
+    return lf;
+  }
+
+  std::shared_ptr<mfem::ParMesh> _pmesh;
+  std::unique_ptr<mfem::FiniteElementCollection> _hcurl_fec, _h1_fec;
+  hephaestus::FESpaces _fespaces;
+  hephaestus::GridFunctions _gridfunctions;
+  hephaestus::Coefficients _coefficients;
+  hephaestus::BCMap _bc_map;
+  mfem::ConstantCoefficient _one{1.0};
+  mfem::ConstantCoefficient _zero{0.0};
+  double _slope{0.0};
+};
+
+TEST_CASE_METHOD(TestScalarPotentialSource, "ScalarPotentialSourceCoefficientTest", "[CheckData]")
+{
+  Setup();
+
+  auto source = MakeSource();
+  const mfem::Vector initial = Apply(*source);
+
+  // Change the conductivity between applications of the same source
+  _slope = 4.0;
+  _coefficients.MarkChanged("conductivity");
+  const mfem::Vector updated = Apply(*source);
+
+  // Same contribution as a source set up with the new conductivity
+  auto reference_source = MakeSource();
+  const mfem::Vector reference = Apply(*reference_source);
+
+  mfem::Vector difference(updated);
+  difference -= reference;
+  const double reference_norm = mfem::ParNormlp(reference, 2, MPI_COMM_WORLD);
+  REQUIRE_THAT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) / reference_norm,
+               Catch::Matchers::WithinAbs(0.0, 1.0e-8));
+
+  // The conductivity change is not ignored
+  difference = updated;
+  difference -= initial;
+  REQUIRE(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD) / reference_norm > 1.0e-2);
+}
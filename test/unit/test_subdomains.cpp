@@ -124,4 +124,44 @@ TEST_CASE("CoefficientsTest", "[CheckData]")
   REQUIRE_THAT(pw->Eval(t, ip), Catch::Matchers::WithinAbs(150.0, eps));
   t.Attribute = 2;
   REQUIRE_THAT(pw->Eval(t, ip), Catch::Matchers::WithinAbs(152.0, eps));
-}
\ No newline at end of file
+}
+TEST_CASE("CoefficientChangeTrackingTest", "[CheckData]")
+{
+  hephaestus::Subdomain wire("wire", 1);
+  wire._scalar_coefficients.Register("constant_property",
+                                     std::make_shared<mfem::ConstantCoefficient>(1.0));
+  wire._scalar_coefficients.Register("varying_property",
+                                     std::make_shared<mfem::FunctionCoefficient>(scalar_f));
+
+  hephaestus::Subdomain air("air", 2);
+  air._scalar_coefficients.Register("constant_property",
+                                    std::make_shared<mfem::ConstantCoefficient>(26.0));
+  air._scalar_coefficients.Register("varying_property",
+                                    std::make_shared<mfem::ConstantCoefficient>(152.0));
+
+  hephaestus::Coefficients coefficients(std::vector<hephaestus::Subdomain>({wire, air}));
+  coefficients._scalars.Register(
+      "derived_property",
+      std::make_shared<mfem::TransformedCoefficient>(
+          coefficients._scalars.Get("_one"),
+          coefficients._scalars.Get("constant_property"),
+          hephaestus::fracFunc));
+  coefficients.SetDependencies("derived_property", {"constant_property"});
+
+  REQUIRE_FALSE(coefficients.IsTimeDependent("constant_property"));
+  REQUIRE_FALSE(coefficients.IsTimeDependent("derived_property"));
+  REQUIRE(coefficients.IsTimeDependent("varying_property"));
+
+  const long constant_sequence = coefficients.GetSequence("constant_property");
+  const long derived_sequence = coefficients.GetSequence("derived_property");
+  const long varying_sequence = coefficients.GetSequence("varying_property");
+
+  coefficients.SetTime(1.0);
+  REQUIRE(coefficients.GetSequence("constant_property") == constant_sequence);
+  REQUIRE(coefficients.GetSequence("derived_property") == derived_sequence);
+  REQUIRE(coefficients.GetSequence("varying_property") != varying_sequence);
+
+  // Changes to parents propagate to derived coefficients
+  coefficients.MarkChanged("constant_property");
+  REQUIRE(coefficients.GetSequence("derived_property") != derived_sequence);
+}